@@ -0,0 +1,206 @@
+/****************************************************************
+ * Author: John J. Patti
+ *
+ * Version: 0.1
+ * Description: 14-Segment Font for the LCD
+ * File: lcdfont.h
+ *
+ * Copyright (c) 2020, John J. Patti
+ * All rights reserved.
+ *
+ * Documents:
+ *  Technical Reference Manual for the MSP430FR6989
+ *  (Document No. SLAU367O) ("TRM")
+ *
+ *  Datasheet for the MSP430FR6989 ("Datasheet")
+ *
+ *  MSP430FR6989 LaunchPad DevelopmentKit(MSP--EXP430FR6989)
+ *  User's Guide (Document No. SLAU627A) ("User's Guide")
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the Software), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ ***************************************************************/
+
+#ifndef LCDFONT_H_
+#define LCDFONT_H_
+
+/****************************************************************
+ * Defines
+ ***************************************************************/
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Segment bits of a 16-bit character word                 |
+//                                                         |
+// The upper byte is written to the LCD position and the   |
+// lower byte to position + 1.  Bits 2 and 0 of the lower  |
+// byte belong to the neg/colon/ant/deg/tx and dp/rx       |
+// indicators, not to the character.  See the segment map  |
+// in liblcd.c.                                            |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define SEG_A           (0x8000)  // Top                   |
+#define SEG_B           (0x4000)  // Upper right           |
+#define SEG_C           (0x2000)  // Lower right           |
+#define SEG_D           (0x1000)  // Bottom                |
+#define SEG_E           (0x0800)  // Lower left            |
+#define SEG_F           (0x0400)  // Upper left            |
+#define SEG_G           (0x0200)  // Middle left           |
+#define SEG_M           (0x0100)  // Middle right          |
+#define SEG_H           (0x0080)  // Upper left diagonal   |
+#define SEG_J           (0x0040)  // Upper center          |
+#define SEG_K           (0x0020)  // Upper right diagonal  |
+#define SEG_P           (0x0010)  // Lower center          |
+#define SEG_Q           (0x0008)  // Lower left diagonal   |
+#define SEG_N           (0x0002)  // Lower right diagonal  |
+#define SEG_ALL         (0xFFFA)  // All character segments|
+//---------------------------------------------------------|
+
+#define LCD_FONT_FIRST  (0x20)    // ' '                   |
+#define LCD_FONT_SIZE   (96)      // 0x20 to 0x7F          |
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Printable ASCII font                                    |
+//                                                         |
+// One entry per character from 0x20 to 0x7F, described by |
+// the segments that are lit.  The list is expanded with   |
+// X(a, code, segments), "a" being passed through from     |
+// LCD_FONT_TABLE(X, a), so that the same description can  |
+// be turned into a lookup table (liblcd.c) or into a      |
+// compile-time glyph (LCD_GLYPH).  Digits and capital     |
+// letters match the digits[] and capletters[] tables;     |
+// lowercase letters use small forms where the 14-segment  |
+// layout allows.                                          |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define LCD_FONT_TABLE(X, a)                                                               \
+    /* ' '  */ X(a, 0x20, 0)                                                               \
+    /* '!'  */ X(a, 0x21, SEG_B | SEG_C)                                                   \
+    /* '"'  */ X(a, 0x22, SEG_B | SEG_J)                                                   \
+    /* '#'  */ X(a, 0x23, SEG_B | SEG_C | SEG_D | SEG_G | SEG_M | SEG_J | SEG_P)           \
+    /* '$'  */ X(a, 0x24, SEG_A | SEG_C | SEG_D | SEG_F | SEG_G | SEG_M | SEG_J | SEG_P)   \
+    /* '%'  */ X(a, 0x25, SEG_C | SEG_F | SEG_K | SEG_Q)                                   \
+    /* '&'  */ X(a, 0x26, SEG_A | SEG_D | SEG_E | SEG_G | SEG_H | SEG_J | SEG_N)           \
+    /* '\'' */ X(a, 0x27, SEG_J)                                                           \
+    /* '('  */ X(a, 0x28, SEG_K | SEG_N)                                                   \
+    /* ')'  */ X(a, 0x29, SEG_H | SEG_Q)                                                   \
+    /* '*'  */ X(a, 0x2A, SEG_G | SEG_M | SEG_H | SEG_J | SEG_K | SEG_P | SEG_Q | SEG_N)   \
+    /* '+'  */ X(a, 0x2B, SEG_G | SEG_M | SEG_J | SEG_P)                                   \
+    /* ','  */ X(a, 0x2C, SEG_Q)                                                           \
+    /* '-'  */ X(a, 0x2D, SEG_G | SEG_M)                                                   \
+    /* '.'  */ X(a, 0x2E, SEG_P)                                                           \
+    /* '/'  */ X(a, 0x2F, SEG_K | SEG_Q)                                                   \
+    /* '0'  */ X(a, 0x30, SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F | SEG_K | SEG_Q)   \
+    /* '1'  */ X(a, 0x31, SEG_B | SEG_C | SEG_K)                                           \
+    /* '2'  */ X(a, 0x32, SEG_A | SEG_B | SEG_D | SEG_E | SEG_G | SEG_M)                   \
+    /* '3'  */ X(a, 0x33, SEG_A | SEG_B | SEG_C | SEG_D | SEG_G | SEG_M)                   \
+    /* '4'  */ X(a, 0x34, SEG_B | SEG_C | SEG_F | SEG_G | SEG_M)                           \
+    /* '5'  */ X(a, 0x35, SEG_A | SEG_C | SEG_D | SEG_F | SEG_G | SEG_M)                   \
+    /* '6'  */ X(a, 0x36, SEG_A | SEG_C | SEG_D | SEG_E | SEG_F | SEG_G | SEG_M)           \
+    /* '7'  */ X(a, 0x37, SEG_A | SEG_B | SEG_C | SEG_F)                                   \
+    /* '8'  */ X(a, 0x38, SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F | SEG_G | SEG_M)   \
+    /* '9'  */ X(a, 0x39, SEG_A | SEG_B | SEG_C | SEG_D | SEG_F | SEG_G | SEG_M)           \
+    /* ':'  */ X(a, 0x3A, SEG_J | SEG_P)                                                   \
+    /* ';'  */ X(a, 0x3B, SEG_J | SEG_Q)                                                   \
+    /* '<'  */ X(a, 0x3C, SEG_K | SEG_N)                                                   \
+    /* '='  */ X(a, 0x3D, SEG_D | SEG_G | SEG_M)                                           \
+    /* '>'  */ X(a, 0x3E, SEG_H | SEG_Q)                                                   \
+    /* '?'  */ X(a, 0x3F, SEG_A | SEG_B | SEG_M | SEG_P)                                   \
+    /* '@'  */ X(a, 0x40, SEG_A | SEG_B | SEG_D | SEG_E | SEG_F | SEG_M | SEG_J)           \
+    /* 'A'  */ X(a, 0x41, SEG_A | SEG_B | SEG_C | SEG_E | SEG_F | SEG_G | SEG_M)           \
+    /* 'B'  */ X(a, 0x42, SEG_A | SEG_B | SEG_C | SEG_D | SEG_M | SEG_J | SEG_P)           \
+    /* 'C'  */ X(a, 0x43, SEG_A | SEG_D | SEG_E | SEG_F)                                   \
+    /* 'D'  */ X(a, 0x44, SEG_A | SEG_B | SEG_C | SEG_D | SEG_J | SEG_P)                   \
+    /* 'E'  */ X(a, 0x45, SEG_A | SEG_D | SEG_E | SEG_F | SEG_G | SEG_M)                   \
+    /* 'F'  */ X(a, 0x46, SEG_A | SEG_E | SEG_F | SEG_G | SEG_M)                           \
+    /* 'G'  */ X(a, 0x47, SEG_A | SEG_C | SEG_D | SEG_E | SEG_F | SEG_M)                   \
+    /* 'H'  */ X(a, 0x48, SEG_B | SEG_C | SEG_E | SEG_F | SEG_G | SEG_M)                   \
+    /* 'I'  */ X(a, 0x49, SEG_A | SEG_D | SEG_J | SEG_P)                                   \
+    /* 'J'  */ X(a, 0x4A, SEG_B | SEG_C | SEG_D | SEG_E)                                   \
+    /* 'K'  */ X(a, 0x4B, SEG_E | SEG_F | SEG_G | SEG_K | SEG_N)                           \
+    /* 'L'  */ X(a, 0x4C, SEG_D | SEG_E | SEG_F)                                           \
+    /* 'M'  */ X(a, 0x4D, SEG_B | SEG_C | SEG_E | SEG_F | SEG_H | SEG_K)                   \
+    /* 'N'  */ X(a, 0x4E, SEG_B | SEG_C | SEG_E | SEG_F | SEG_H | SEG_N)                   \
+    /* 'O'  */ X(a, 0x4F, SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F)                   \
+    /* 'P'  */ X(a, 0x50, SEG_A | SEG_B | SEG_E | SEG_F | SEG_G | SEG_M)                   \
+    /* 'Q'  */ X(a, 0x51, SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F | SEG_N)           \
+    /* 'R'  */ X(a, 0x52, SEG_A | SEG_B | SEG_E | SEG_F | SEG_G | SEG_M | SEG_N)           \
+    /* 'S'  */ X(a, 0x53, SEG_A | SEG_C | SEG_D | SEG_F | SEG_G | SEG_M)                   \
+    /* 'T'  */ X(a, 0x54, SEG_A | SEG_J | SEG_P)                                           \
+    /* 'U'  */ X(a, 0x55, SEG_B | SEG_C | SEG_D | SEG_E | SEG_F)                           \
+    /* 'V'  */ X(a, 0x56, SEG_E | SEG_F | SEG_K | SEG_Q)                                   \
+    /* 'W'  */ X(a, 0x57, SEG_B | SEG_C | SEG_E | SEG_F | SEG_Q | SEG_N)                   \
+    /* 'X'  */ X(a, 0x58, SEG_H | SEG_K | SEG_Q | SEG_N)                                   \
+    /* 'Y'  */ X(a, 0x59, SEG_H | SEG_K | SEG_P)                                           \
+    /* 'Z'  */ X(a, 0x5A, SEG_A | SEG_D | SEG_K | SEG_Q)                                   \
+    /* '['  */ X(a, 0x5B, SEG_A | SEG_D | SEG_E | SEG_F)                                   \
+    /* '\\' */ X(a, 0x5C, SEG_H | SEG_N)                                                   \
+    /* ']'  */ X(a, 0x5D, SEG_A | SEG_B | SEG_C | SEG_D)                                   \
+    /* '^'  */ X(a, 0x5E, SEG_Q | SEG_N)                                                   \
+    /* '_'  */ X(a, 0x5F, SEG_D)                                                           \
+    /* '`'  */ X(a, 0x60, SEG_H)                                                           \
+    /* 'a'  */ X(a, 0x61, SEG_D | SEG_E | SEG_G | SEG_P)                                   \
+    /* 'b'  */ X(a, 0x62, SEG_C | SEG_D | SEG_E | SEG_F | SEG_G | SEG_M)                   \
+    /* 'c'  */ X(a, 0x63, SEG_D | SEG_E | SEG_G | SEG_M)                                   \
+    /* 'd'  */ X(a, 0x64, SEG_B | SEG_C | SEG_D | SEG_E | SEG_G | SEG_M)                   \
+    /* 'e'  */ X(a, 0x65, SEG_D | SEG_E | SEG_G | SEG_Q)                                   \
+    /* 'f'  */ X(a, 0x66, SEG_G | SEG_M | SEG_K | SEG_P)                                   \
+    /* 'g'  */ X(a, 0x67, SEG_A | SEG_B | SEG_C | SEG_D | SEG_M | SEG_H)                   \
+    /* 'h'  */ X(a, 0x68, SEG_C | SEG_E | SEG_F | SEG_G | SEG_M)                           \
+    /* 'i'  */ X(a, 0x69, SEG_P)                                                           \
+    /* 'j'  */ X(a, 0x6A, SEG_B | SEG_C | SEG_D)                                           \
+    /* 'k'  */ X(a, 0x6B, SEG_J | SEG_K | SEG_P | SEG_N)                                   \
+    /* 'l'  */ X(a, 0x6C, SEG_E | SEG_F)                                                   \
+    /* 'm'  */ X(a, 0x6D, SEG_C | SEG_E | SEG_G | SEG_M | SEG_P)                           \
+    /* 'n'  */ X(a, 0x6E, SEG_C | SEG_E | SEG_G | SEG_M)                                   \
+    /* 'o'  */ X(a, 0x6F, SEG_C | SEG_D | SEG_E | SEG_G | SEG_M)                           \
+    /* 'p'  */ X(a, 0x70, SEG_A | SEG_B | SEG_E | SEG_F | SEG_G | SEG_M)                   \
+    /* 'q'  */ X(a, 0x71, SEG_A | SEG_B | SEG_C | SEG_F | SEG_G | SEG_M)                   \
+    /* 'r'  */ X(a, 0x72, SEG_E | SEG_G)                                                   \
+    /* 's'  */ X(a, 0x73, SEG_A | SEG_C | SEG_D | SEG_F | SEG_G | SEG_M)                   \
+    /* 't'  */ X(a, 0x74, SEG_D | SEG_E | SEG_F | SEG_G)                                   \
+    /* 'u'  */ X(a, 0x75, SEG_C | SEG_D | SEG_E)                                           \
+    /* 'v'  */ X(a, 0x76, SEG_E | SEG_Q)                                                   \
+    /* 'w'  */ X(a, 0x77, SEG_C | SEG_E | SEG_Q | SEG_N)                                   \
+    /* 'x'  */ X(a, 0x78, SEG_H | SEG_K | SEG_Q | SEG_N)                                   \
+    /* 'y'  */ X(a, 0x79, SEG_B | SEG_C | SEG_D | SEG_F | SEG_G | SEG_M)                   \
+    /* 'z'  */ X(a, 0x7A, SEG_D | SEG_G | SEG_Q)                                           \
+    /* '{'  */ X(a, 0x7B, SEG_A | SEG_D | SEG_G | SEG_J | SEG_P)                           \
+    /* '|'  */ X(a, 0x7C, SEG_J | SEG_P)                                                   \
+    /* '}'  */ X(a, 0x7D, SEG_A | SEG_D | SEG_M | SEG_J | SEG_P)                           \
+    /* '~'  */ X(a, 0x7E, SEG_G | SEG_K)                                                   \
+    /* DEL  */ X(a, 0x7F, SEG_ALL)
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Compile-time glyph lookup                               |
+//                                                         |
+// LCD_GLYPH(c) expands the font into a chain of           |
+// conditionals on the character constant "c", so it folds |
+// to the segment word and can be used in static           |
+// initializers (see LCD_FRAME in liblcd.h).  Characters   |
+// outside the font light every segment (see lcd_glyph).   |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define LCD_GLYPH_IF(c, code, segs)     ((c) == (code)) ? (segs) :
+#define LCD_GLYPH(c)    (LCD_FONT_TABLE(LCD_GLYPH_IF, c) SEG_ALL)
+
+#endif /* LCDFONT_H_ */
@@ -40,13 +40,15 @@
  ***************************************************************/
 
 #include "liblcd.h"
+#include "libsetup.h"
 #include <msp430.h>
 #include <stdint.h>
 #include <string.h>
-#include <stdlib.h>
+#include <stdarg.h>
 
 /***************************************************************
- * @brief   Constant Arrays for Digits and Capital Letters
+ * @brief   Font Table and Constant Arrays for Digits and
+ *          Capital Letters
  * @param   None
  * @return  None
  *
@@ -160,6 +162,19 @@
  *
  **************************************************************/
 
+#define LCD_FONT_ENTRY(a, code, segs)   (segs),
+
+const uint16_t lcd_font[LCD_FONT_SIZE] = {
+                             //---------------------------------------------------------|
+                             ///////////////////////////////////////////////////////////|
+                             // Printable ASCII, indexed by (char - 0x20).  Generated   |
+                             // from the segment descriptions in lcdfont.h.             |
+                             ///////////////////////////////////////////////////////////|
+                             //---------------------------------------------------------|
+                             LCD_FONT_TABLE(LCD_FONT_ENTRY, 0)
+                             //---------------------------------------------------------|
+};
+
 const uint16_t digits[10] = {
                              //---------------------------------------------------------|
                              ///////////////////////////////////////////////////////////|
@@ -234,496 +249,3042 @@ const uint16_t b2_sym = 0x20;   // For LCD_AT3
 const uint16_t b4_sym = 0x40;   // For LCD_AT3
 const uint16_t b6_sym = 0x80;   // For LCD_AT3
 
+/****************************************************************
+ * Symbol table
+ ***************************************************************/
+typedef struct{
+    uint8_t offset;             // LCD memory index of the symbol
+    uint8_t mask;               // Segment bit within that byte
+} lcd_sym_t;
+
+static const lcd_sym_t lcd_sym_table[LCD_SYM_COUNT] = {     // Indexed by symbol - 1
+    { LCD_A1 + 1, 0x04 },       // NEG_SYM
+    { LCD_A2 + 1, 0x04 },       // COLON1_SYM
+    { LCD_A4 + 1, 0x04 },       // COLON2_SYM
+    { LCD_A1 + 1, 0x01 },       // DP1_SYM
+    { LCD_A2 + 1, 0x01 },       // DP2_SYM
+    { LCD_A3 + 1, 0x01 },       // DP3_SYM
+    { LCD_A4 + 1, 0x01 },       // DP4_SYM
+    { LCD_A5 + 1, 0x01 },       // DP5_SYM
+    { LCD_A3 + 1, 0x04 },       // ANT_SYM
+    { LCD_A5 + 1, 0x04 },       // DEG_SYM
+    { LCD_A6 + 1, 0x04 },       // TX_SYM
+    { LCD_A6 + 1, 0x01 },       // RX_SYM
+    { LCD_AT1,    0x01 },       // EXCL_SYM
+    { LCD_AT1,    0x02 },       // REC_SYM
+    { LCD_AT1,    0x04 },       // HRT_SYM
+    { LCD_AT1,    0x08 },       // TMR_SYM
+    { LCD_AT2,    0x10 },       // BRKT_SYM
+    { LCD_AT2,    0x20 },       // B1_SYM
+    { LCD_AT2,    0x40 },       // B3_SYM
+    { LCD_AT2,    0x80 },       // B5_SYM
+    { LCD_AT3,    0x10 },       // BATT_SYM
+    { LCD_AT3,    0x20 },       // B2_SYM
+    { LCD_AT3,    0x40 },       // B4_SYM
+    { LCD_AT3,    0x80 }        // B6_SYM
+};
+
+/****************************************************************
+ * Shadow framebuffer
+ ***************************************************************/
+#define LCD_DIRTY_ALL   (0xFFFFFFFFUL >> (32 - LCD_MEM_SIZE))
+
+#define LCD_IND_BITS    (0x05)  // Indicator bits in a position's low byte
+#define LCD_TIMING_BITS (LCDDIV__32 | 0x0700)   // LCDDIVx and LCDPREx in LCDCCTL0
+
+static uint8_t lcd_text[LCD_MEM_SIZE];      // Glyph plane
+static uint8_t lcd_ind[LCD_MEM_SIZE];       // Indicator plane
+static uint8_t lcd_folded[LCD_MEM_SIZE];    // Indicator bits lit by text or numbers
+static uint8_t lcd_shadow[LCD_MEM_SIZE];    // Composite, RAM copy of LCDMEM
+static uint8_t lcd_hw[2][LCD_MEM_SIZE];     // Last bytes written to LCDMEM
+                                            // (bank 0) and LCDBMEM (bank 1)
+static uint32_t lcd_dirty[2];               // Bit n set ==> byte n touched
+static uint8_t lcd_hw_stale;                // Bit n set ==> lcd_hw[n] unknown,
+                                            // the bank was written by DMA
+static uint8_t lcd_autoflush = 1;           // Commit after every API call
+static uint8_t lcd_dbuf;                    // Double buffering enabled
+static uint8_t lcd_dbuf_resume;             // Blinking suspended double
+                                            // buffering; resume it after
+static uint8_t lcd_page;                    // Bank currently on display
+static uint8_t lcd_blink[LCD_MEM_SIZE];     // Blink mask, mirrors LCDBMEM
+static uint8_t lcd_blinking;                // LCDBMEM holds the blink mask
+static uint16_t lcd_blink_ctl = BLINK_1HZ;  // LCDCBLKCTL divider/prescaler
+static lcd_config_t lcd_cfg;                // Configuration in use
+static uint8_t lcd_unsaved;                 // Settings or blink mask differ
+                                            // from lcd_fram
+static uint32_t lcd_unsaved_bytes;          // Bit n set ==> byte n of the
+                                            // planes not yet in lcd_fram
+static uint8_t lcd_fram_ok;                 // lcd_fram.sum is valid
+
+static const uint8_t lcd_positions[6] = {
+    LCD_A1, LCD_A2, LCD_A3, LCD_A4, LCD_A5, LCD_A6
+};
+
+static const uint8_t lcd_punct[6] = {       // Indicator bits each position lends
+    0x05, 0x05, 0x01, 0x05, 0x01, 0x00      // to text: NEG/DP1, COL1/DP2, DP3,
+};                                          // COL2/DP4, DP5, none on A6
+
 /***************************************************************
- * @brief   Displays a Capital Letter or Digits on the display
- * @param   "symbol"  - input char; must be 0-9 or A-Z
- *
- *          "position" - memory position number; must be one of
- *          the following, which are defined in liblcd.h:
- *          LCD_A1, LCD_A2, LCD_A3, LCD_A4, LCD_A5, or LCD_A6
+ * @brief   Writes one byte of the composite shadow framebuffer
+ * @param   "idx" - LCD memory index (LCD Memory idx+1)
+ *          "val" - new byte value
+ * @return  None
  *
+ * The byte is only marked dirty when its value changes.  A byte
+ * that is changed and then restored before the next flush (e.g.
+ * display_num clearing and redrawing an unchanged digit) is
+ * filtered out by lcd_flush.
+ **************************************************************/
+static void lcd_put(uint8_t idx, uint8_t val)
+{
+    if (lcd_shadow[idx] != val)
+    {
+        lcd_shadow[idx] = val;
+        lcd_dirty[0] |= (uint32_t) 1 << idx;
+        lcd_dirty[1] |= (uint32_t) 1 << idx;
+    }
+}
+
+/***************************************************************
+ * @brief   Recomposites one byte from the glyph and indicator
+ *          planes
+ * @param   "idx" - LCD memory index
  * @return  None
+ *
+ * The low byte of a position shares bit 2 and bit 0 between the
+ * glyph and the indicators (neg, colon, dp, ant, deg, tx, rx).
+ * Glyphs never carry those bits in lcd_text, so or'ing the
+ * planes lets text and symbols change without erasing each
+ * other, still with one write per changed byte.
  **************************************************************/
-void display_char(char symbol, int position)
+static void lcd_compose(uint8_t idx)
+{
+    lcd_put(idx, lcd_text[idx] | lcd_ind[idx]);
+    lcd_unsaved_bytes |= (uint32_t) 1 << idx;
+}
+
+/***************************************************************
+ * @brief   Returns the 16-bit character word of a character
+ * @param   "symbol" - input char
+ * @return  Segment word from the font table, or 0xFFFF (all
+ *          segments) for characters outside 0x20-0x7F
+ **************************************************************/
+static uint16_t lcd_glyph(char symbol)
 {
     //---------------------------------------------------------------------------------|
-    unsigned int i = (unsigned int) symbol;     // Stores input char as an int         |
-    uint16_t symb_val;                          // 16-bit input word for the LCD Mem   |
+    uint8_t i;                                  // Index into the font table           |
                                                 //                                     |
-    if (symbol == ' ')                          // Input word is blank for a space     |
-        symb_val = 0;                           //                                     |
-    else if (symbol >= '0' && symbol <= '9')    // Determines if symbol is a digit     |
-    {                                           //                                     |
-        i -= 48;                                // Digits start 48 or "0" = 0x30 = 48  |
-        symb_val = digits[i];                   // stores word from constant array     |
-    }                                           //                                     |
-    else if (symbol >= 'A' && symbol <= 'Z')    // Determines if symbol is a capital   |
-    {                                           //                                     |
-        i -= 65;                                // Caps start 65 or "A" = 0x41 = 65    |
-        symb_val = capletters[i];               // stores word from constant array     |
-    }                                           //                                     |
-    else                                        //  Error trap                         |
-        symb_val = 0xFFFF;                      //  All segments are activated         |
-                                                //                                     |
-    LCDMEM[position] = symb_val >> 8;           //  Write upper portion to memory 1    |
-    LCDMEM[position+1] = symb_val & 0xFF;       //  Write lower portion to memory 2    |
+    i = (uint8_t) symbol - LCD_FONT_FIRST;      // Offset from ' '; wraps below 0x20   |
+    if (i < LCD_FONT_SIZE)                      // Printable ASCII: one indexed load   |
+        return lcd_font[i];                     //                                     |
+    return 0xFFFF;                              //  Error trap: all segments activated |
     //---------------------------------------------------------------------------------|
 }
 
 /***************************************************************
- * @brief   Displays symbol
- * @param   symbol number ==> set in defines
+ * @brief   Loads a 16-bit word into a position of the shadow
+ *          framebuffer without committing it
+ * @param   "position" - LCD_A1 to LCD_A6
+ *          "word"     - glyph, plus any indicators in "ind"
+ *          "ind"      - indicator bits (LCD_IND_BITS) of the
+ *                       low byte taken from "word"; the others
+ *                       keep their state
  * @return  None
+ *
+ * The bits of "ind" lit by "word" are recorded in lcd_folded, so
+ * the next text or number may clear them again.
  **************************************************************/
-void display_symbol(uint8_t sym)
+static void lcd_put_cell(int position, uint16_t word, uint8_t ind)
 {
-    switch(sym){
-        case NEG_SYM:
-            LCDMEM[LCD_A1 + 1] |= neg_sym;
-            break;
-        case COLON1_SYM:
-            LCDMEM[LCD_A2 + 1] |= colon;
-            break;
-        case COLON2_SYM:
-            LCDMEM[LCD_A4 + 1] |= colon;
-            break;
-        case DP1_SYM:
-            LCDMEM[LCD_A2 + 1] |= dec_pt;
-            break;
-        case DP2_SYM:
-            LCDMEM[LCD_A3 + 1] |= dec_pt;
-            break;
-        case DP3_SYM:
-            LCDMEM[LCD_A3 + 1] |= dec_pt;
-            break;
-        case DP4_SYM:
-            LCDMEM[LCD_A4 + 1] |= dec_pt;
-            break;
-        case DP5_SYM:
-            LCDMEM[LCD_A5 + 1] |= dec_pt;
-            break;
-        case ANT_SYM:
-            LCDMEM[LCD_A3 + 1] |= antenna;
-            break;
-        case DEG_SYM:
-            LCDMEM[LCD_A5 + 1] |= deg_sym;
-            break;
-        case TX_SYM:
-            LCDMEM[LCD_A6 + 1] |= tx_sym;
-            break;
-        case RX_SYM:
-            LCDMEM[LCD_A6 + 1] |= rx_sym;
-            break;
-        case EXCL_SYM:
-            LCDMEM[LCD_AT1] |= excl_sym;
-            break;
-        case REC_SYM:
-            LCDMEM[LCD_AT1] |= rec_sym;
-            break;
-        case HRT_SYM:
-            LCDMEM[LCD_AT1] |= hrt_sym;
-            break;
-        case TMR_SYM:
-            LCDMEM[LCD_AT1] |= tmr_sym;
-            break;
-        case BRKT_SYM:
-            LCDMEM[LCD_AT2] |= brackets;
-            break;
-        case B1_SYM:
-            LCDMEM[LCD_AT2] |= b1_sym;
-            break;
-        case B3_SYM:
-            LCDMEM[LCD_AT2] |= b3_sym;
-            break;
-        case B5_SYM:
-            LCDMEM[LCD_AT2] |= b5_sym;
-            break;
-        case BATT_SYM:
-            LCDMEM[LCD_AT3] |= batt_sym;
-            break;
-        case B2_SYM:
-            LCDMEM[LCD_AT3] |= b2_sym;
-            break;
-        case B4_SYM:
-            LCDMEM[LCD_AT3] |= b4_sym;
-            break;
-        case B6_SYM:
-            LCDMEM[LCD_AT3] |= b6_sym;
-            break;
-        default:
-            break;
-    }
+    lcd_text[position] = word >> 8;
+    lcd_text[position + 1] = word & ~LCD_IND_BITS;
+    lcd_ind[position + 1] = (lcd_ind[position + 1] & ~ind) | (word & ind);
+    lcd_folded[position + 1] = (lcd_folded[position + 1] & ~ind) | (word & ind);
+    lcd_compose(position);
+    lcd_compose(position + 1);
 }
 
 /***************************************************************
- * @brief   Clears symbol
- * @param   symbol number ==> set in defines
+ * @brief   Loads a glyph into a position of the shadow
+ *          framebuffer, keeping its indicators
+ * @param   "position" - LCD_A1 to LCD_A6
+ *          "word"     - upper byte to position, lower byte to
+ *                       position + 1
  * @return  None
  **************************************************************/
-void clear_symbol(uint8_t sym)
+static void lcd_put_word(int position, uint16_t word)
+{
+    lcd_put_cell(position, word, 0);
+}
+
+/***************************************************************
+ * @brief   Loads a character into a position of the shadow
+ *          framebuffer without committing it
+ * @param   "symbol"   - input char
+ *          "position" - LCD_A1 to LCD_A6
+ * @return  None
+ **************************************************************/
+static void lcd_put_char(char symbol, int position)
+{
+    lcd_put_word(position, lcd_glyph(symbol));
+}
+
+/***************************************************************
+ * @brief   Clears the whole shadow framebuffer without
+ *          committing it
+ * @param   None
+ * @return  None
+ **************************************************************/
+static void lcd_clear_shadow(void)
+{
+    uint8_t i;
+
+    memset(lcd_text, 0, LCD_MEM_SIZE);
+    memset(lcd_ind, 0, LCD_MEM_SIZE);
+    memset(lcd_folded, 0, LCD_MEM_SIZE);
+    lcd_unsaved_bytes = LCD_DIRTY_ALL;
+    for (i = 0; i < LCD_MEM_SIZE; i++)
+        lcd_put(i, 0x00);
+}
+
+/***************************************************************
+ * @brief   Commits the shadow framebuffer if auto-flush is on
+ * @param   None
+ * @return  None
+ **************************************************************/
+static void lcd_commit(void)
+{
+    if (lcd_autoflush)
+        lcd_flush();
+}
+
+/***************************************************************
+ * @brief   Returns whether a bank still differs from the shadow
+ * @param   "bank" - 0 for LCDMEM, 1 for LCDBMEM
+ * @return  1 if at least one byte differs, otherwise 0
+ *
+ * Dirty bits of bytes that turn out to match are dropped.
+ **************************************************************/
+static uint8_t lcd_bank_stale(uint8_t bank)
 {
-    switch(sym)
+    uint32_t dirty = lcd_dirty[bank];
+    uint8_t i;
+
+    if (lcd_hw_stale & (1 << bank))
+        return 1;
+    for (i = 0; dirty != 0; i++, dirty >>= 1)
     {
-        case NEG_SYM:
-            LCDMEM[LCD_A1 + 1] &= ~neg_sym;
-            break;
-        case COLON1_SYM:
-            LCDMEM[LCD_A2 + 1] &= ~colon;
-            break;
-        case COLON2_SYM:
-            LCDMEM[LCD_A4 + 1] &= ~colon;
-            break;
-        case DP1_SYM:
-            LCDMEM[LCD_A2 + 1] &= ~dec_pt;
-            break;
-        case DP2_SYM:
-            LCDMEM[LCD_A3 + 1] &= ~dec_pt;
-            break;
-        case DP3_SYM:
-            LCDMEM[LCD_A3 + 1] &= ~dec_pt;
-            break;
-        case DP4_SYM:
-            LCDMEM[LCD_A4 + 1] &= ~dec_pt;
-            break;
-        case DP5_SYM:
-            LCDMEM[LCD_A5 + 1] &= ~dec_pt;
-            break;
-        case ANT_SYM:
-            LCDMEM[LCD_A3 + 1] &= ~antenna;
-            break;
-        case DEG_SYM:
-            LCDMEM[LCD_A5 + 1] &= ~deg_sym;
-            break;
-        case TX_SYM:
-            LCDMEM[LCD_A6 + 1] &= ~tx_sym;
-            break;
-        case RX_SYM:
-            LCDMEM[LCD_A6 + 1] &= ~rx_sym;
-            break;
-        case EXCL_SYM:
-            LCDMEM[LCD_AT1] &= ~excl_sym;
-            break;
-        case REC_SYM:
-            LCDMEM[LCD_AT1] &= ~rec_sym;
-            break;
-        case HRT_SYM:
-            LCDMEM[LCD_AT1] &= ~hrt_sym;
-            break;
-        case TMR_SYM:
-            LCDMEM[LCD_AT1] &= ~tmr_sym;
-            break;
-        case BRKT_SYM:
-            LCDMEM[LCD_AT2] &= ~brackets;
-            break;
-        case B1_SYM:
-            LCDMEM[LCD_AT2] &= ~b1_sym;
-            break;
-        case B3_SYM:
-            LCDMEM[LCD_AT2] &= ~b3_sym;
-            break;
-        case B5_SYM:
-            LCDMEM[LCD_AT2] &= ~b5_sym;
-            break;
-        case BATT_SYM:
-            LCDMEM[LCD_AT3] &= ~batt_sym;
-            break;
-        case B2_SYM:
-            LCDMEM[LCD_AT3] &= ~b2_sym;
-            break;
-        case B4_SYM:
-            LCDMEM[LCD_AT3] &= ~b4_sym;
-            break;
-        case B6_SYM:
-            LCDMEM[LCD_AT3] &= ~b6_sym;
-            break;
-        default:
-            break;
+        if ((dirty & 1) && lcd_hw[bank][i] != lcd_shadow[i])
+            return 1;
+        lcd_dirty[bank] &= ~((uint32_t) 1 << i);
     }
+    return 0;
 }
 
 /***************************************************************
- * @brief   Clears a memory segment
- * @param   "position" - memory position number; must be one of
- *          the following, which are defined in liblcd.h:
- *          LCD_A1, LCD_A2, LCD_A3, LCD_A4, LCD_A5 or LCD_A6
- *
+ * @brief   Writes the dirty shadow bytes into one bank
+ * @param   "bank" - 0 for LCDMEM, 1 for LCDBMEM
  * @return  None
+ *
+ * A bank last written by DMA is rewritten whole, as lcd_hw does
+ * not know what it holds.
  **************************************************************/
-void clear_lcd_mem(int position)
+static void lcd_write_bank(uint8_t bank)
 {
-    LCDMEM[position] = 0x00;
-    LCDMEM[position+1] = 0x00;
-    LCDBMEM[position] = 0x00;
-    LCDBMEM[position+1] = 0x00;
+    uint32_t dirty = lcd_dirty[bank];
+    uint8_t i, stale = lcd_hw_stale & (1 << bank);
+
+    if (stale)
+        dirty = LCD_DIRTY_ALL;
+    for (i = 0; dirty != 0; i++, dirty >>= 1)
+    {
+        if ((dirty & 1) && (stale || lcd_hw[bank][i] != lcd_shadow[i]))
+        {
+            lcd_hw[bank][i] = lcd_shadow[i];
+            if (bank)
+                LCDBMEM[i] = lcd_shadow[i];
+            else
+                LCDMEM[i] = lcd_shadow[i];
+        }
+    }
+    lcd_dirty[bank] = 0;
+    lcd_hw_stale &= ~(1 << bank);
 }
 
+/****************************************************************
+ * FRAM copy of the display
+ ***************************************************************/
+#define LCD_FRAM_SEED   (0x4C43)    // Checksum start; an erased
+                                    // record never matches
+
+typedef struct{
+    lcd_config_t cfg;                   // Timing and power
+    uint8_t text[LCD_MEM_SIZE];         // Glyph plane
+    uint8_t ind[LCD_MEM_SIZE];          // Indicator plane
+    uint8_t folded[LCD_MEM_SIZE];       // Indicators lit by text
+    uint8_t blink[LCD_MEM_SIZE];        // Blink mask
+    uint16_t blink_ctl;                 // Blink rate
+    uint8_t blinking;                   // Blinking on
+    uint8_t dbuf;                       // Double buffering on
+    uint8_t dbuf_resume;                // Suspended by blinking
+    uint16_t sum;                       // lcd_fram_sum() if valid
+} lcd_fram_t;
+
+LIB_FRAM(lcd_fram)
+static lcd_fram_t lcd_fram = {
+    { 0, 0, 0, 0, 0, { 0 } }, { 0 }, { 0 }, { 0 }, { 0 }, 0, 0, 0, 0, 0
+};
+
 /***************************************************************
- * @brief   Clears all memory segments
+ * @brief   Computes the checksum of the FRAM record
  * @param   None
- * @return  None
+ * @return  Sum of every byte before "sum", from LCD_FRAM_SEED
+ *
+ * A plain sum, so lcd_save() can update it byte by byte.
  **************************************************************/
-void clear_lcd(void)
+static uint16_t lcd_fram_sum(void)
 {
-    clear_lcd_mem(LCD_A1);
-    clear_lcd_mem(LCD_A2);
-    clear_lcd_mem(LCD_A3);
-    clear_lcd_mem(LCD_A4);
-    clear_lcd_mem(LCD_A5);
-    clear_lcd_mem(LCD_A6);
-    LCDMEM[LCD_AT1] = 0x00;
-    LCDMEM[LCD_AT2] = 0x00;
-    LCDMEM[LCD_AT3] = 0x00;
-    LCDBMEM[LCD_AT1] = 0x00;
-    LCDBMEM[LCD_AT2] = 0x00;
-    LCDBMEM[LCD_AT3] = 0x00;
-    LCDM14 = 0x00;
-    LCDBM14 = 0x00;
-    LCDM18 = 0x00;
-    LCDBM18 = 0x00;
-    LCDM3 = 0x00;
-    LCDBM3 = 0x00;
+    const uint8_t *p = (const uint8_t*) &lcd_fram;
+    uint16_t sum = LCD_FRAM_SEED, n;
+
+    for (n = 0; n < sizeof(lcd_fram) - sizeof(lcd_fram.sum); n++)
+        sum += p[n];
+    return sum;
 }
 
 /***************************************************************
- * @brief   Scrolls Message Across LCD
- * @param   string "msg"
+ * @brief   Copies the bytes of a field that differ into the
+ *          FRAM record
+ * @param   "dst" - field of lcd_fram
+ *          "src" - library state
+ *          "n"   - size in bytes
+ * @return  Change of the checksum
+ **************************************************************/
+static uint16_t lcd_fram_put(void *dst, const void *src, uint8_t n)
+{
+    uint8_t *d = (uint8_t*) dst;
+    const uint8_t *s = (const uint8_t*) src;
+    uint16_t delta = 0;
+
+    for (; n > 0; n--, d++, s++)
+    {
+        if (*d != *s)
+        {
+            delta += (uint16_t) *s - *d;
+            *d = *s;
+        }
+    }
+    return delta;
+}
+
+/***************************************************************
+ * @brief   Brings the FRAM record for lcd_restore() up to date
+ * @param   None
  * @return  None
+ *
+ * Called by lcd_flush(), so after a reset or brownout the
+ * display comes back as it was last shown, and by the blink and
+ * power profile calls, which do not flush.  Only the plane
+ * bytes drawn since the last save are compared, and only those
+ * that differ are written, so an update that changes one digit
+ * writes two or three bytes and the checksum.  The settings and
+ * the blink mask are compared when one of them was changed.
+ *
+ * The checksum is invalidated first and written last, so a
+ * reset in the middle of a save leaves a record that is not
+ * restored.  Interrupts are disabled meanwhile, as the scroll,
+ * clock and timer ISRs also flush.
+ *
+ * Call it directly only after drawing with auto-flush off, if
+ * the frame must survive a reset before the next lcd_flush().
  **************************************************************/
-void scroll_text(char *msg)
+void lcd_save(void)
 {
     //----------------------------------------------------------------------------------|
-    ////////////////////////////////////////////////////////////////////////////////////|
-    char *buf;                                  // Print buffer                         |
-    int i, len;                                 // Loop variable and string length      |
-                                                ////////////////////////////////////////|
-    len = strlen(msg);                          // Writes string length to len          |
+    uint16_t gie, sum;                          // Caller's GIE, new checksum           |
+    uint32_t bytes;                             // Plane bytes to compare               |
+    uint8_t i;                                  //                                      |
                                                 ////////////////////////////////////////|
-    buf = malloc(sizeof(char) * (len + 12));    // Allocates print buffer size. Note    |
-                                                // the buffer includes six spaces before|
-                                                // and after the string.                |
-                                                ////////////////////////////////////////|
-    for(i = 0; i < len + 12; i++)               // Fill loop                            |
+    if (!lcd_unsaved && !lcd_unsaved_bytes)     // Nothing drawn since the last save    |
+        return;                                 //                                      |
+    gie = __get_SR_register() & GIE;            //                                      |
+    __disable_interrupt();                      //                                      |
+    bytes = lcd_unsaved_bytes;                  //                                      |
+    if (!lcd_fram_ok)                           // First save since reset: whole record |
     {                                           //                                      |
-        if (i < 6)                              // Load print buffer with string with 6 |
-            buf[i] = ' ';                       // blank spaces before and after.       |
-        else if (i > len + 5)                   //                                      |
-            buf[i] = ' ';                       //                                      |
-        else                                    //                                      |
-            buf[i] = msg[i - 6];                //                                      |
+        bytes = LCD_DIRTY_ALL;                  //                                      |
+        lcd_unsaved = 1;                        //                                      |
     }                                           //                                      |
+    lcd_unsaved_bytes = 0;                      //                                      |
+    sum = lcd_fram.sum;                         //                                      |
+    lcd_fram.sum = ~sum;                        // Invalid until complete               |
                                                 ////////////////////////////////////////|
-    for(i = 0; i < len + 7; i++)                // Print loop                           |
+    for (i = 0; bytes != 0; i++, bytes >>= 1)   // Planes, byte by byte                 |
     {                                           //                                      |
-        display_char(buf[i], LCD_A1);           // Loads each position with a character |
-        display_char(buf[i + 1], LCD_A2);       // from the print buffer.  The          |
-        display_char(buf[i + 2], LCD_A3);       // characters are incremented over      |
-        display_char(buf[i + 3], LCD_A4);       // position to allow for smooth, scorll-|
-        display_char(buf[i + 4], LCD_A5);       // text.                                |
-        display_char(buf[i + 5], LCD_A6);       //                                      |
-                                                //                                      |
-        __delay_cycles(2000000);                // Delay between loops of 250ms so that |
-                                                // the text does not move too fast.     |
-    }                                           ////////////////////////////////////////|
-    free(buf);                                  // Free allocated memory                |
-    clear_lcd();                                // clear the LCD                        |
-                                                //                                      |
-    __delay_cycles(2000000);                    // Delay of 250ms so that to allow      |
-                                                // everything to clear.                 |
+        if (!(bytes & 1))                       //                                      |
+            continue;                           //                                      |
+        sum += lcd_fram_put(&lcd_fram.text[i], &lcd_text[i], 1);                    //  |
+        sum += lcd_fram_put(&lcd_fram.ind[i], &lcd_ind[i], 1);                      //  |
+        sum += lcd_fram_put(&lcd_fram.folded[i], &lcd_folded[i], 1);                //  |
+    }                                           //                                      |
+    if (lcd_unsaved)                            // Settings and blinking                |
+    {                                           //                                      |
+        sum += lcd_fram_put(&lcd_fram.cfg, &lcd_cfg, sizeof(lcd_cfg));              //  |
+        sum += lcd_fram_put(lcd_fram.blink, lcd_blink, LCD_MEM_SIZE);               //  |
+        sum += lcd_fram_put(&lcd_fram.blink_ctl, &lcd_blink_ctl, 2);                //  |
+        sum += lcd_fram_put(&lcd_fram.blinking, &lcd_blinking, 1);                  //  |
+        sum += lcd_fram_put(&lcd_fram.dbuf, &lcd_dbuf, 1);                          //  |
+        sum += lcd_fram_put(&lcd_fram.dbuf_resume, &lcd_dbuf_resume, 1);            //  |
+        lcd_unsaved = 0;                        //                                      |
+    }                                           //                                      |
+    if (!lcd_fram_ok)                           // Old checksum meant nothing           |
+        sum = lcd_fram_sum();                   //                                      |
+    lcd_fram.sum = sum;                         // Valid again                          |
+    lcd_fram_ok = 1;                            //                                      |
+    if (gie)                                    //                                      |
+        __enable_interrupt();                   //                                      |
     //----------------------------------------------------------------------------------|
 }
 
 /***************************************************************
- * @brief   Displays static message on LCD (limited to 6
- *          characters)
- * @param   string "msg"
- * @return  None
+ * @brief   Loads the library state from a valid FRAM record
+ * @param   None
+ * @return  1 if the record was valid and loaded, otherwise 0
+ *
+ * The composite shadow is rebuilt and marked dirty, the hardware
+ * registers are not touched.
  **************************************************************/
-void display_msg(char *msg)
+static uint8_t lcd_load(void)
 {
-    //----------------------------------------------------------------------------------|
-    ////////////////////////////////////////////////////////////////////////////////////|
-    char buf[6] = "      ";                     // Print buffer                         |
-    int i, len, lp;                             // Loop, string length, truncate        |
-                                                ////////////////////////////////////////|
-    len = strlen(msg);                          // Writes string length to len          |
-                                                ////////////////////////////////////////|
-    if(len > 6)                                 // Fill length loop.  Fills to 6 or to  |
-        lp = 6;                                 // the truncation value                 |
-    else                                        //                                      |
-        lp = len;                               //                                      |
-                                                ////////////////////////////////////////|
-    for(i = 0; i < lp; i++)                     // Fill loop                            |
-        buf[i] = msg[i];                        //                                      |
-                                                ////////////////////////////////////////|
-    display_char(buf[0], LCD_A1);               // Print buffer on LCD                  |
-    display_char(buf[1], LCD_A2);               //                                      |
-    display_char(buf[2], LCD_A3);               //                                      |
-    display_char(buf[3], LCD_A4);               //                                      |
-    display_char(buf[4], LCD_A5);               //                                      |
-    display_char(buf[5], LCD_A6);               //                                      |
-    //----------------------------------------------------------------------------------|
+    uint8_t i;
+
+    if (lcd_fram.sum != lcd_fram_sum())
+        return 0;
+    lcd_fram_ok = 1;
+    memcpy(lcd_text, lcd_fram.text, LCD_MEM_SIZE);
+    memcpy(lcd_ind, lcd_fram.ind, LCD_MEM_SIZE);
+    memcpy(lcd_folded, lcd_fram.folded, LCD_MEM_SIZE);
+    memcpy(lcd_blink, lcd_fram.blink, LCD_MEM_SIZE);
+    lcd_blink_ctl = lcd_fram.blink_ctl;
+    lcd_blinking = lcd_fram.blinking;
+    lcd_dbuf = lcd_fram.dbuf;
+    lcd_dbuf_resume = lcd_fram.dbuf_resume;
+    for (i = 0; i < LCD_MEM_SIZE; i++)
+        lcd_compose(i);
+    lcd_dirty[0] = LCD_DIRTY_ALL;
+    lcd_dirty[1] = LCD_DIRTY_ALL;
+    return 1;
 }
 
+/****************************************************************
+ * DMA commit
+ ***************************************************************/
+#if LCD_USE_DMA
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__) || \
+    (defined(__GNUC__) && defined(__MSP430__))
+#define LCD_DMA_ADDR(reg, p)    __data16_write_addr((unsigned short) &(reg), \
+                                                    (unsigned long) (uintptr_t) (p))
+#else
+#define LCD_DMA_ADDR(reg, p)    ((reg) = (p))
+#endif
+
+#define LCD_DMA_CTL     (DMADT_2 | DMASRCINCR_3 | DMADSTINCR_3 | DMASBDB | DMAIE)
+
+static uint8_t lcd_dma;                     // Commit through DMA channel 0
+static volatile uint8_t lcd_dma_run;        // Completion not yet signalled
+static uint8_t lcd_dma_swap;                // Show the bank once it is filled
+static uint8_t lcd_dma_again;               // Flushed while a block was moving
+static lcd_callback_t lcd_dma_done;         // Completion callback
+static lcd_dma_callback_t lcd_dma_other;    // Gets the other DMA interrupts
+
 /***************************************************************
- * @brief   Initialize LCD
+ * @brief   Starts a DMA block with the changed part of the
+ *          shadow framebuffer
  * @param   None
  * @return  None
+ *
+ * The block runs from the first to the last dirty byte, so an
+ * update that changes one digit moves two bytes.  In
+ * double-buffered mode it fills the hidden bank, which the DMA
+ * ISR then shows, as in lcd_flush.  A flush while a block is
+ * still moving is sent by the ISR once that block is done.
  **************************************************************/
-void init_lcd(void)
+static void lcd_dma_flush(void)
 {
     //---------------------------------------------------------|
-    ///////////////////////////////////////////////////////////|
-    //                                                         |
-    // NOTE: The MSP-EXP4306989 uses Segments S4, S6-S21,      |
-    // S27-S31 and S35-S39.  See SLAU627A at pg. 13            |
-    //                                                         |
-    // For LCD configuration see Chapter 36 of the TRM         |
-    //                                                         |
-    ///////////////////////////////////////////////////////////|
-    //---------------------------------------------------------|
-    uint16_t lcdctl0_ctx = 0;           // Sets divider to 1,  |
-                                        // source to ACLK      |
-                                        //                     |
-    uint16_t lcdcpctl0_ctx = 0;         // Sets cxt for segment|
-    uint16_t lcdcpctl1_ctx = 0;         // registers to 0      |
-    uint16_t lcdcpctl2_ctx = 0;         //                     |
-                                        //                     |
-    lcdctl0_ctx |= LCDPRE__16;          // Prescaler to 16     |
-    lcdctl0_ctx |= LCD4MUX;             // 4 mux               |
-    lcdctl0_ctx |= LCDLP;               // LP wavefrorms       |
-    lcdctl0_ctx &= ~LCDON;              // ensure LCD is off   |
-                                        //                     |
-    LCDCCTL0  = lcdctl0_ctx;            // load ctx to register|
-                                        //                     |
-    lcdcpctl0_ctx |= LCDS4;             // Enable segments     |
-    lcdcpctl0_ctx |= LCDS6;             //                     |
-    lcdcpctl0_ctx |= LCDS7;             //                     |
-    lcdcpctl0_ctx |= LCDS8;             //                     |
-    lcdcpctl0_ctx |= LCDS9;             //                     |
-    lcdcpctl0_ctx |= LCDS10;            //                     |
-    lcdcpctl0_ctx |= LCDS11;            //                     |
-    lcdcpctl0_ctx |= LCDS12;            //                     |
-    lcdcpctl0_ctx |= LCDS13;            //                     |
-    lcdcpctl0_ctx |= LCDS14;            //                     |
-    lcdcpctl0_ctx |= LCDS15;            //                     |
-    lcdcpctl1_ctx |= LCDS16;            //                     |
-    lcdcpctl1_ctx |= LCDS17;            //                     |
-    lcdcpctl1_ctx |= LCDS18;            //                     |
-    lcdcpctl1_ctx |= LCDS19;            //                     |
-    lcdcpctl1_ctx |= LCDS20;            //                     |
-    lcdcpctl1_ctx |= LCDS21;            //                     |
-    lcdcpctl1_ctx |= LCDS27;            //                     |
-    lcdcpctl1_ctx |= LCDS28;            //                     |
-    lcdcpctl1_ctx |= LCDS29;            //                     |
-    lcdcpctl1_ctx |= LCDS30;            //                     |
-    lcdcpctl1_ctx |= LCDS31;            //                     |
-    lcdcpctl2_ctx |= LCDS35;            //                     |
-    lcdcpctl2_ctx |= LCDS36;            //                     |
-    lcdcpctl2_ctx |= LCDS37;            //                     |
-    lcdcpctl2_ctx |= LCDS38;            //                     |
-    lcdcpctl2_ctx |= LCDS39;            //                     |
-                                        //                     |
-    LCDCPCTL0 = lcdcpctl0_ctx;          // load ctxs into      |
-    LCDCPCTL1 = lcdcpctl1_ctx;          // register            |
-    LCDCPCTL2 = lcdcpctl2_ctx;          //                     |
-                                        //                     |
-    LCDCVCTL = LCDCPEN | VLCD_8;        // CP config           |
-    LCDCCPCTL = LCDCPCLKSYNC;           //                     |
-                                        //                     |
-    LCDCMEMCTL = LCDCLRM;               // clear memory        |
-                                        //                     |
-    LCDCCTL0 |= LCDON;                  // LCD on              |
+    uint32_t dirty;                 //                         |
+    uint8_t bank = 0, first = 0, n = 0;                    //  |
+                                    ///////////////////////////|
+    if (lcd_dma_run)                // Previous block moving   |
+    {                               //                         |
+        lcd_dma_again = 1;          //                         |
+        return;                     //                         |
+    }                               //                         |
+    if (lcd_dbuf)                   // Double buffer: fill     |
+    {                               // the hidden bank if      |
+        if (!lcd_dirty[lcd_page])   // the one on display      |
+            return;                 // is stale                |
+        bank = lcd_page ^ 1;        //                         |
+    }                               //                         |
+    dirty = lcd_dirty[bank];        //                         |
+    if (!dirty)                     // Nothing changed         |
+        return;                     //                         |
+    while (!(dirty & 1))            // Span of dirty bytes     |
+    {                               //                         |
+        dirty >>= 1;                //                         |
+        first++;                    //                         |
+    }                               //                         |
+    for (; dirty != 0; dirty >>= 1) //                         |
+        n++;                        //                         |
+                                    //                         |
+    lcd_dirty[bank] = 0;            //                         |
+    lcd_hw_stale |= 1 << bank;      // CPU compare is now off  |
+    lcd_dma_swap = lcd_dbuf;        //                         |
+    lcd_dma_run = 1;                //                         |
+    LCD_DMA_ADDR(DMA0SA, lcd_shadow + first);              //  |
+    if (bank)                       //                         |
+        LCD_DMA_ADDR(DMA0DA, LCDBMEM + first);             //  |
+    else                            //                         |
+        LCD_DMA_ADDR(DMA0DA, LCDMEM + first);              //  |
+    DMA0SZ = n;                     //                         |
+    DMA0CTL = LCD_DMA_CTL | DMAEN;  // Burst-block             |
+    DMA0CTL |= DMAREQ;              // Start                   |
     //---------------------------------------------------------|
 }
 
 /***************************************************************
- * @brief   Disables LCD
+ * @brief   Finishes the DMA block in flight
  * @param   None
  * @return  None
+ *
+ * Shows the filled bank in double-buffered mode and calls the
+ * completion callback.  Runs from the DMA ISR, or from
+ * lcd_dma_wait() with interrupts disabled.
  **************************************************************/
-void lcd_off(void)
+static void lcd_dma_end(void)
+{
+    if (lcd_dma_swap)
+    {
+        lcd_page ^= 1;
+        LCDCMEMCTL ^= LCDDISP;
+    }
+    lcd_dma_run = 0;
+    if (lcd_dma_done)
+        lcd_dma_done();
+}
+
+/***************************************************************
+ * @brief   Waits for the DMA block in flight, if any
+ * @param   None
+ * @return  None
+ *
+ * Used before the banks are switched or handed back to the CPU.
+ * The block is at most 20 bytes, so this is a short spin; the
+ * pending interrupt flag is cleared so the ISR does not finish
+ * the block a second time.
+ **************************************************************/
+static void lcd_dma_wait(void)
 {
     //---------------------------------------------------------|
-    ///////////////////////////////////////////////////////////|
-    //                                                         |
-    // NOTE: The MSP-EXP4306989 uses Segments S4, S6-S21,      |
-    // S27-S31 and S35-S39.  See SLAU627A at pg. 13            |
-    //                                                         |
-    // For LCD configuration see Chapter 36 of the TRM         |
-    //                                                         |
-    ///////////////////////////////////////////////////////////|
+    uint16_t gie = __get_SR_register() & GIE;              //  |
+                                    ///////////////////////////|
+    __disable_interrupt();          // ISR must not race us    |
+    while (DMA0CTL & DMAEN)         // Block still moving      |
+        ;                           //                         |
+    if (lcd_dma_run)                // ISR has not run yet     |
+    {                               //                         |
+        DMA0CTL &= ~DMAIFG;         //                         |
+        lcd_dma_end();              //                         |
+    }                               //                         |
+    lcd_dma_again = 0;              // Caller flushes next     |
+    if (gie)                        //                         |
+        __enable_interrupt();       //                         |
     //---------------------------------------------------------|
-    LCDCCTL0 &= ~LCDON;             // Turns LCD off           |
+}
+
+/***************************************************************
+ * @brief   Switches the commit path between the CPU and DMA
+ * @param   "on"   - 1 to copy frames with DMA channel 0, 0 to
+ *                   write the changed bytes with the CPU
+ *          "done" - called from the DMA ISR after each frame,
+ *                   or 0
+ * @return  None
+ *
+ * With DMA on, lcd_flush() only starts the copy of the changed
+ * span (LCD Memory 1-20, or the blink bank in double-buffered
+ * mode) and returns.  The block runs in burst-block mode: the
+ * CPU gets two MCLK cycles after every four bytes, or waits in
+ * LPM0 until "done" is called from the DMA ISR.  Drawing while
+ * a frame is moving is safe; the bytes it changes are sent in
+ * one more block when the first one is done.
+ *
+ * The DMA writes LCDMEM without the per-byte compare of the CPU
+ * path, so switching DMA off marks the banks it wrote as
+ * unknown and the next CPU flush rewrites them whole.
+ *
+ * NOTE: Only built with LCD_USE_DMA; DMA channel 0 and
+ * DMA_VECTOR are used while this is on.  The other DMA
+ * channels' interrupts go to lcd_dma_set_callback().
+ **************************************************************/
+void lcd_set_dma(uint8_t on, lcd_callback_t done)
+{
+    //---------------------------------------------------------|
+    if (!on)                        // Let the last block land |
+        lcd_dma_wait();             //                         |
+    lcd_dma_done = done;            //                         |
+    if (on)                         //                         |
+        DMACTL0 &= ~DMA0TSEL_31;    // Trigger: DMAREQ         |
+    lcd_dma = on;                   //                         |
     //---------------------------------------------------------|
 }
 
 /***************************************************************
- * @brief   Enables LCD
+ * @brief   Returns whether a DMA frame is still unsignalled
  * @param   None
+ * @return  1 until the DMA ISR has run for the last frame
+ **************************************************************/
+uint8_t lcd_dma_busy(void)
+{
+    return lcd_dma_run;
+}
+
+/***************************************************************
+ * @brief   Sets the handler for the DMA interrupts the commit
+ *          path does not use
+ * @param   "cb" - called from the DMA ISR with the DMAIV value
+ *                 (DMA1, DMA2, ...), or 0
  * @return  None
+ *
+ * The library owns DMA_VECTOR when LCD_USE_DMA is 1, so the
+ * application enables its DMA channel interrupts as usual and
+ * handles them here.
  **************************************************************/
-void lcd_on(void)
+void lcd_dma_set_callback(lcd_dma_callback_t cb)
+{
+    lcd_dma_other = cb;
+}
+
+/***************************************************************
+ * @brief   DMA ISR; shows a completed frame and passes every
+ *          other interrupt to the callback
+ * @param   None
+ * @return  None
+ **************************************************************/
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=DMA_VECTOR
+__interrupt void dma_isr(void)
+#elif defined(__GNUC__) && defined(__MSP430__)
+void __attribute__ ((interrupt(DMA_VECTOR))) dma_isr(void)
+#else
+void dma_isr(void)
+#endif
+{
+    uint16_t iv = DMAIV;
+
+    if (iv == DMAIV_DMA0IFG)
+    {
+        if (!lcd_dma_run)       // Already finished by lcd_dma_wait()
+            return;
+        lcd_dma_end();
+        if (lcd_dma_again)      // Drawn while the block was moving
+        {
+            lcd_dma_again = 0;
+            lcd_dma_flush();
+        }
+    }
+    else if (iv != DMAIV__NONE && lcd_dma_other)
+        lcd_dma_other(iv);
+}
+#endif /* LCD_USE_DMA */
+
+/***************************************************************
+ * @brief   Writes every changed shadow byte to the LCD
+ * @param   None
+ * @return  None
+ *
+ * Only bytes that differ from what was last written are
+ * written, so an update that changes one digit costs one or
+ * two register writes instead of a full redraw.
+ *
+ * In double-buffered mode the bytes are written into the bank
+ * that is not on display, and LCDDISP then switches the display
+ * to it, so the whole frame appears at once.
+ *
+ * With lcd_set_dma() on, the changed bytes are handed to a DMA
+ * block instead and this returns before they reach the glass.
+ **************************************************************/
+static void lcd_show(void)
 {
     //---------------------------------------------------------|
-    ///////////////////////////////////////////////////////////|
-    //                                                         |
-    // NOTE: The MSP-EXP4306989 uses Segments S4, S6-S21,      |
-    // S27-S31 and S35-S39.  See SLAU627A at pg. 13            |
-    //                                                         |
-    // For LCD configuration see Chapter 36 of the TRM         |
-    //                                                         |
-    ///////////////////////////////////////////////////////////|
-    //---------------------------------------------------------|
-    LCDCCTL0 |= LCDON;            // Turns on LCD              |
+#if LCD_USE_DMA
+    if (lcd_dma)                    // Whole frame by DMA      |
+    {                               //                         |
+        lcd_dma_flush();            //                         |
+        return;                     //                         |
+    }                               //                         |
+#endif
+    if (!lcd_dbuf)                  // Single buffer: update   |
+    {                               // LCDMEM in place         |
+        lcd_write_bank(0);          //                         |
+        return;                     //                         |
+    }                               //                         |
+                                    ///////////////////////////|
+    if (!lcd_bank_stale(lcd_page))  // Frame on display is     |
+        return;                     // already current         |
+                                    //                         |
+    lcd_write_bank(lcd_page ^ 1);   // Render hidden bank      |
+    lcd_page ^= 1;                  //                         |
+    LCDCMEMCTL ^= LCDDISP;          // Swap banks              |
     //---------------------------------------------------------|
 }
 
 /***************************************************************
- * @brief   Displays static number on LCD (limited to 6
- *          digits)
- * @param   input integer
+ * @brief   Shows the shadow framebuffer and saves it in FRAM
+ * @param   None
  * @return  None
+ *
+ * The changed bytes go to the glass as lcd_show() describes,
+ * then lcd_save() copies them into the FRAM record, so the
+ * frame on display is the one lcd_restore() brings back after
+ * a reset or brownout.
  **************************************************************/
-void display_num(int in)
+void lcd_flush(void)
 {
-    //----------------------------------------------------------------------------------|
-    ////////////////////////////////////////////////////////////////////////////////////|
-    int i, temp;                                // Loop and dummy                       |
-    char buf[6] = "      ";                     // Print buffer                         |
-    clear_lcd();                                // Clear the LCD                        |
-                                                ////////////////////////////////////////|
-    for(i = 0; i < 6; i++)                      // int-to-string conversion loop        |
-    {                                           //                                      |
-        temp = in % 10;                         //                                      |
-        if (temp == 0)                          //                                      |
-            buf[i] = '0';                       //                                      |
-        else if (temp == 1)                     //                                      |
-            buf[i] = '1';                       //                                      |
-        else if (temp == 2)                     //                                      |
-            buf[i] = '2';                       //                                      |
-        else if (temp == 3)                     //                                      |
-            buf[i] = '3';                       //                                      |
-        else if (temp == 4)                     //                                      |
-            buf[i] = '4';                       //                                      |
-        else if (temp == 5)                     //                                      |
-            buf[i] = '5';                       //                                      |
-        else if (temp == 6)                     //                                      |
-            buf[i] = '6';                       //                                      |
-        else if (temp == 7)                     //                                      |
-            buf[i] = '7';                       //                                      |
-        else if (temp == 8)                     //                                      |
-            buf[i] = '8';                       //                                      |
-        else                                    //                                      |
-            buf[i] = '9';                       //                                      |
-        in /= 10;                               //                                      |
-        if (in == 0)                            //                                      |
-            break;                              //                                      |
-    }                                           ////////////////////////////////////////|
-    display_char(buf[5], LCD_A1);               // Print buffer on LCD                  |
-    display_char(buf[4], LCD_A2);               //                                      |
-    display_char(buf[3], LCD_A3);               //                                      |
-    display_char(buf[2], LCD_A4);               //                                      |
-    display_char(buf[1], LCD_A5);               //                                      |
-    display_char(buf[0], LCD_A6);               //                                      |
+    lcd_show();
+    lcd_save();
+}
+
+/***************************************************************
+ * @brief   Rescales an LCD_C divider and prescaler written for
+ *          an ACLK of LFXT_HZ to the ACLK now running
+ * @param   "ctl"     - register value holding the pair
+ *          "pre_pos" - bit position of the 3-bit prescaler
+ *          "pre_max" - largest prescaler code
+ *          "div_pos" - bit position of the divider
+ *          "div_max" - largest divide ratio
+ * @return  "ctl" with the pair replaced
+ *
+ * The frame and blink clocks are both ACLK / ((DIV + 1) * 2^PRE)
+ * (times a fixed factor), and the profiles and BLINK_x rates are
+ * written for LFXT_HZ.  The ratio is scaled by the ACLK from
+ * clk_get() and split again with the smallest prescaler that
+ * keeps the divider in range, so the rate stays as close as the
+ * register allows.
+ **************************************************************/
+static uint16_t lcd_aclk_scale(uint16_t ctl, uint8_t pre_pos, uint8_t pre_max,
+                               uint8_t div_pos, uint8_t div_max)
+{
+    uint32_t aclk = clk_get()->aclk;
+    uint8_t pre = (ctl >> pre_pos) & 7;
+    uint32_t n = (uint32_t) (((ctl >> div_pos) & (div_max - 1)) + 1) << pre;
+    uint16_t div;
+
+    if (aclk == LFXT_HZ)                // Written for this clock
+        return ctl;
+    n = (n * aclk + LFXT_HZ / 2) / LFXT_HZ;
+    for (pre = 0; pre < pre_max && n > ((uint32_t) div_max << pre); pre++)
+        ;
+    div = (uint16_t) ((n + ((1UL << pre) >> 1)) >> pre);
+    if (div == 0)
+        div = 1;
+    if (div > div_max)
+        div = div_max;
+    ctl &= ~((7U << pre_pos) | ((div_max - 1U) << div_pos));
+    return ctl | ((uint16_t) pre << pre_pos) | ((div - 1U) << div_pos);
+}
+
+/***************************************************************
+ * @brief   LCDDIVx/LCDPREx for the current ACLK
+ * @param   "timing" - lcd_config_t timing for LFXT_HZ
+ * @return  LCDCCTL0 divider and prescaler bits
+ **************************************************************/
+static uint16_t lcd_frame_div(uint16_t timing)
+{
+    return lcd_aclk_scale(timing & LCD_TIMING_BITS, 8, 5, 11, 32);
+}
+
+/***************************************************************
+ * @brief   LCDBLKDIVx/LCDBLKPREx for lcd_blink_rate() at the
+ *          current ACLK
+ * @param   None
+ * @return  LCDCBLKCTL divider and prescaler bits
+ **************************************************************/
+static uint16_t lcd_blink_div(void)
+{
+    return lcd_aclk_scale(lcd_blink_ctl, 2, 7, 5, 8);
+}
+
+/***************************************************************
+ * @brief   Turns segment blinking off and releases LCDBMEM
+ * @param   None
+ * @return  None
+ *
+ * The blink mask stays in LCDBMEM; lcd_hw[1] mirrors it so a
+ * later double-buffer resync rewrites exactly what differs.
+ **************************************************************/
+static void lcd_blink_stop(void)
+{
+    LCDCBLKCTL = lcd_blink_div() | LCDBLKMOD_0;
+    memset(lcd_blink, 0, LCD_MEM_SIZE);
+    lcd_blinking = 0;
+    lcd_unsaved = 1;
+}
+
+/***************************************************************
+ * @brief   Enables or disables double buffering
+ * @param   "on" - 1 to render into the hidden bank and swap
+ *          banks with LCDDISP, 0 to update LCDMEM in place
+ * @return  None
+ *
+ * NOTE: The blinking memory (LCDBMEM) is used as the second
+ * bank, and LCDDISP is only honoured while LCDBLKMODx = 00, so
+ * double buffering cannot be combined with segment blinking.
+ * Enabling it stops any blinking.  Blinking started while it is
+ * on suspends it until the blink mask is empty again; calling
+ * this function in between cancels that.
+ **************************************************************/
+void lcd_set_double_buffer(uint8_t on)
+{
+    //---------------------------------------------------------|
+    if (lcd_dbuf_resume)            // Caller's choice wins    |
+        lcd_unsaved = 1;            // over the suspended one  |
+    lcd_dbuf_resume = 0;            //                         |
+    if (on == lcd_dbuf)             // Nothing to do           |
+        return;                     //                         |
+#if LCD_USE_DMA
+    lcd_dma_wait();                 // Bank swap still pending |
+#endif
+                                    //                         |
+    if (on && lcd_blinking)         // LCDBMEM becomes a bank  |
+        lcd_blink_stop();           //                         |
+    lcd_dirty[0] = LCD_DIRTY_ALL;   // Resync both banks       |
+    lcd_dirty[1] = LCD_DIRTY_ALL;   //                         |
+    lcd_dbuf = on;                  //                         |
+    lcd_unsaved = 1;                //                         |
+    if (!on && lcd_page)            // Bring LCDMEM up to date |
+    {                               // and show it again       |
+        lcd_write_bank(0);          //                         |
+        lcd_page = 0;               //                         |
+        LCDCMEMCTL &= ~LCDDISP;     //                         |
+    }                               //                         |
+    lcd_commit();                   //                         |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Enables or disables the automatic flush at the end
+ *          of every drawing call
+ * @param   "on" - 1 to flush after each call (default), 0 to
+ *          only draw into the shadow until lcd_flush() is called
+ * @return  None
+ *
+ * Disabling auto-flush lets several calls (e.g. a number plus
+ * its symbols) be composed and committed together.
+ **************************************************************/
+void lcd_set_autoflush(uint8_t on)
+{
+    lcd_autoflush = on;
+    lcd_commit();
+}
+
+/***************************************************************
+ * @brief   Displays a character on the display
+ * @param   "symbol"  - input char; any printable ASCII character
+ *          (0x20-0x7E).  Other values light every segment.
+ *
+ *          "position" - memory position number; must be one of
+ *          the following, which are defined in liblcd.h:
+ *          LCD_A1, LCD_A2, LCD_A3, LCD_A4, LCD_A5, or LCD_A6
+ *
+ * @return  None
+ **************************************************************/
+void display_char(char symbol, int position)
+{
+    lcd_put_char(symbol, position);
+    lcd_commit();
+}
+
+/***************************************************************
+ * @brief   Sets and clears groups of symbols
+ * @param   "set_mask"   - symbols to light, SYM_MASK(n) bits
+ *          "clear_mask" - symbols to blank, SYM_MASK(n) bits
+ * @return  None
+ *
+ * The bits are collected per LCD memory byte first so every
+ * byte touched is updated once, however many of its symbols
+ * change; e.g. SYM_MASK_BATT lights the whole battery gauge
+ * with two writes.  A symbol in both masks ends up lit.
+ **************************************************************/
+void lcd_symbols_set(uint32_t set_mask, uint32_t clear_mask)
+{
+    //----------------------------------------------------------------------------------|
+    uint8_t set[LCD_MEM_SIZE];                  // Bits to set per byte                 |
+    uint8_t clr[LCD_MEM_SIZE];                  // Bits to clear per byte               |
+    uint32_t touched = 0;                       // Bytes with changes                   |
+    uint32_t bit;                               // Current symbol mask bit              |
+    uint8_t i, idx;                             //                                      |
+                                                ////////////////////////////////////////|
+    memset(set, 0, sizeof(set));                //                                      |
+    memset(clr, 0, sizeof(clr));                //                                      |
+    for (i = 0, bit = 1; i < LCD_SYM_COUNT; i++, bit <<= 1) //                          |
+    {                                           //                                      |
+        if (!((set_mask | clear_mask) & bit))   //                                      |
+            continue;                           //                                      |
+        idx = lcd_sym_table[i].offset;          //                                      |
+        if (set_mask & bit)                     //                                      |
+            set[idx] |= lcd_sym_table[i].mask;  //                                      |
+        else                                    //                                      |
+            clr[idx] |= lcd_sym_table[i].mask;  //                                      |
+        touched |= (uint32_t) 1 << idx;         //                                      |
+    }                                           //                                      |
+                                                ////////////////////////////////////////|
+    for (idx = 0; touched; idx++, touched >>= 1)    // One update per byte              |
+        if (touched & 1)                        // of the indicator plane               |
+        {                                       //                                      |
+            lcd_ind[idx] = (lcd_ind[idx] & ~clr[idx]) | set[idx];                   //  |
+            lcd_folded[idx] &= ~(clr[idx] | set[idx]);  // Now owned by the caller      |
+            lcd_compose(idx);                   //                                      |
+        }                                       //                                      |
+    lcd_commit();                               //                                      |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Displays symbol
+ * @param   symbol number ==> set in defines
+ * @return  None
+ **************************************************************/
+void display_symbol(uint8_t sym)
+{
+    if (sym != NONE_SYM && sym <= LCD_SYM_COUNT)
+        lcd_symbols_set(SYM_MASK(sym), 0);
+}
+
+/***************************************************************
+ * @brief   Clears symbol
+ * @param   symbol number ==> set in defines
+ * @return  None
+ **************************************************************/
+void clear_symbol(uint8_t sym)
+{
+    if (sym != NONE_SYM && sym <= LCD_SYM_COUNT)
+        lcd_symbols_set(0, SYM_MASK(sym));
+}
+
+/****************************************************************
+ * Segment blinking
+ ***************************************************************/
+/***************************************************************
+ * @brief   Sets or clears bits of the blink mask
+ * @param   "idx"  - LCD memory index
+ *          "mask" - segment bits
+ *          "on"   - 1 to blink the segments, 0 to stop
+ * @return  None
+ *
+ * With LCDBLKMODx = 01 a segment blinks when its bit is set in
+ * both LCDMEM and LCDBMEM, so the mask marks where blinking is
+ * allowed and the normal drawing calls decide what is lit.  The
+ * LCD_C module then blinks on its own from ACLK; the CPU is not
+ * involved.  Double buffering uses LCDBMEM as its second bank,
+ * so it is suspended while anything blinks and turned back on
+ * when the last blinking segment is released.
+ **************************************************************/
+static void lcd_blink_bits(uint8_t idx, uint8_t mask, uint8_t on)
+{
+    //----------------------------------------------------------------------------------|
+    uint8_t val, i, any = 0;                    //                                      |
+    uint8_t dbuf = lcd_dbuf;                    // Application's setting                |
+                                                ////////////////////////////////////////|
+    if (on && !lcd_blinking)                    // Take over LCDBMEM                    |
+    {                                           //                                      |
+        lcd_set_double_buffer(0);               //                                      |
+        lcd_dbuf_resume = dbuf;                 // Back on when nothing blinks          |
+        LCDCMEMCTL |= LCDCLRBM;                 // Drop the old bank contents           |
+        memset(lcd_hw[1], 0, LCD_MEM_SIZE);     //                                      |
+        lcd_hw_stale &= ~2;                     //                                      |
+        LCDCBLKCTL = lcd_blink_div() | LCDBLKMOD_1; // Blink individual segments        |
+        lcd_blinking = 1;                       //                                      |
+    }                                           //                                      |
+    if (!lcd_blinking)                          // Nothing blinks                       |
+        return;                                 //                                      |
+                                                ////////////////////////////////////////|
+    val = on ? (lcd_blink[idx] | mask) : (lcd_blink[idx] & ~mask);                  //  |
+    if (val != lcd_blink[idx])                  // Single write per change              |
+    {                                           //                                      |
+        lcd_blink[idx] = val;                   //                                      |
+        lcd_hw[1][idx] = val;                   //                                      |
+        LCDBMEM[idx] = val;                     //                                      |
+    }                                           //                                      |
+    for (i = 0; i < LCD_MEM_SIZE; i++)          // Stop the module once the mask is     |
+        any |= lcd_blink[i];                    // empty                                |
+    if (!any)                                   //                                      |
+    {                                           //                                      |
+        lcd_blink_stop();                       //                                      |
+        if (lcd_dbuf_resume)                    // Return LCDBMEM to double buffering   |
+            lcd_set_double_buffer(1);           //                                      |
+    }                                           //                                      |
+    lcd_unsaved = 1;                            //                                      |
+    lcd_save();                                 // Nothing is flushed                   |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Blinks the character at a position
+ * @param   "position" - LCD_A1 to LCD_A6
+ *          "on"       - 1 to blink, 0 to stop blinking
+ * @return  None
+ *
+ * The character keeps blinking when it is redrawn.  Indicators
+ * sharing the position (colon, dp, ...) are not affected; use
+ * lcd_blink_symbol() for those.
+ **************************************************************/
+void lcd_blink_position(int position, uint8_t on)
+{
+    lcd_blink_bits(position, 0xFF, on);
+    lcd_blink_bits(position + 1, (uint8_t) ~LCD_IND_BITS, on);
+}
+
+/***************************************************************
+ * @brief   Blinks a symbol
+ * @param   "sym" - symbol number ==> set in defines
+ *          "on"  - 1 to blink, 0 to stop blinking
+ * @return  None
+ *
+ * E.g. lcd_blink_symbol(EXCL_SYM, 1) followed by
+ * display_symbol(EXCL_SYM) flashes the exclamation point.
+ **************************************************************/
+void lcd_blink_symbol(uint8_t sym, uint8_t on)
+{
+    if (sym != NONE_SYM && sym <= LCD_SYM_COUNT)
+        lcd_blink_bits(lcd_sym_table[sym - 1].offset,
+                       lcd_sym_table[sym - 1].mask, on);
+}
+
+/***************************************************************
+ * @brief   Selects the blink frequency
+ * @param   "rate" - BLINK_4HZ, BLINK_2HZ, BLINK_1HZ (default) or
+ *          BLINK_0_5HZ, or any LCDBLKPRE_x | LCDBLKDIV_x value
+ * @return  None
+ **************************************************************/
+void lcd_blink_rate(uint16_t rate)
+{
+    lcd_blink_ctl = rate & (LCDBLKPRE_7 | LCDBLKDIV_7);
+    LCDCBLKCTL = lcd_blink_div() | (lcd_blinking ? LCDBLKMOD_1 : LCDBLKMOD_0);
+    lcd_unsaved = 1;
+    lcd_save();
+}
+
+/****************************************************************
+ * Battery gauge
+ ***************************************************************/
+const lcd_battery_t lcd_battery_default = {
+    { 5, 20, 40, 60, 80, 95 },  // B1 to B6
+    3,                          // Hysteresis
+    1                           // Blink [] when empty
+};
+
+static const uint32_t lcd_batt_bars[BATT_LEVELS + 1] = {   // Bars lit per level
+    0,
+    SYM_MASK(B1_SYM),
+    SYM_MASK(B1_SYM) | SYM_MASK(B2_SYM),
+    SYM_MASK(B1_SYM) | SYM_MASK(B2_SYM) | SYM_MASK(B3_SYM),
+    SYM_MASK_BAR & ~(SYM_MASK(B5_SYM) | SYM_MASK(B6_SYM)),
+    SYM_MASK_BAR & ~SYM_MASK(B6_SYM),
+    SYM_MASK_BAR
+};
+
+static const lcd_battery_t *lcd_batt_cfg = &lcd_battery_default;
+static uint8_t lcd_batt_level;              // Level shown, for hysteresis
+
+/***************************************************************
+ * @brief   Selects the battery gauge thresholds
+ * @param   "cfg" - e.g. &lcd_battery_default
+ * @return  None
+ **************************************************************/
+void lcd_battery_config(const lcd_battery_t *cfg)
+{
+    lcd_batt_cfg = cfg;
+}
+
+/***************************************************************
+ * @brief   Shows a battery charge on the gauge
+ * @param   "percent" - 0 to 100
+ * @return  None
+ *
+ * The level only moves up when "percent" reaches the next
+ * threshold and only moves down when it drops "hyst" below the
+ * current one.  When the level and the gauge on display are
+ * unchanged nothing is written; otherwise BATT, [] and the bars
+ * are updated with one lcd_symbols_set() call, i.e. at most one
+ * write to each of LCD_AT2 and LCD_AT3.  With no bar left and
+ * "blink_empty" set, the LCD_C blinks the brackets; double
+ * buffering, if on, is suspended until a bar is lit again (see
+ * lcd_set_double_buffer()).
+ **************************************************************/
+void lcd_battery_level(uint8_t percent)
+{
+    //----------------------------------------------------------------------------------|
+    const lcd_battery_t *cfg = lcd_batt_cfg;    //                                      |
+    const lcd_sym_t *batt = &lcd_sym_table[BATT_SYM - 1];                           //  |
+    uint8_t lvl = lcd_batt_level;               //                                      |
+                                                ////////////////////////////////////////|
+    while (lvl < BATT_LEVELS && percent >= cfg->thresh[lvl])                        //  |
+        lvl++;                                  // Charging                             |
+    while (lvl > 0 && percent + cfg->hyst < cfg->thresh[lvl - 1])                   //  |
+        lvl--;                                  // Discharging                          |
+    if (lvl == lcd_batt_level && (lcd_ind[batt->offset] & batt->mask))              //  |
+        return;                                 // Gauge already shows it               |
+    lcd_batt_level = lvl;                       //                                      |
+                                                ////////////////////////////////////////|
+    lcd_blink_symbol(BRKT_SYM, (lvl == 0 && cfg->blink_empty) ? 1 : 0);             //  |
+    lcd_symbols_set(SYM_MASK(BATT_SYM) | SYM_MASK(BRKT_SYM) | lcd_batt_bars[lvl],   //  |
+                    SYM_MASK_BAR & ~lcd_batt_bars[lvl]);                            //  |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Clears the character of a memory segment
+ * @param   "position" - memory position number; must be one of
+ *          the following, which are defined in liblcd.h:
+ *          LCD_A1, LCD_A2, LCD_A3, LCD_A4, LCD_A5 or LCD_A6
+ *
+ * @return  None
+ *
+ * Indicators sharing the position (colon, dp, ...) stay lit;
+ * use clear_symbol() for those.
+ **************************************************************/
+void clear_lcd_mem(int position)
+{
+    lcd_put_word(position, 0x0000);
+    lcd_commit();
+}
+
+/***************************************************************
+ * @brief   Clears all memory segments
+ * @param   None
+ * @return  None
+ **************************************************************/
+void clear_lcd(void)
+{
+    lcd_clear_shadow();
+    lcd_commit();
+}
+
+/****************************************************************
+ * Timebase
+ ***************************************************************/
+#if LCD_USE_DELAY || LCD_USE_SCROLL
+/***************************************************************
+ * @brief   Converts milliseconds to ACLK / 8 timer counts
+ * @param   "ms" - time in ms
+ * @return  Timer counts, at least 1
+ *
+ * ACLK comes from LFXT (or another oscillator below 40 kHz), so
+ * the product fits 32 bits for any 16-bit "ms".
+ **************************************************************/
+static uint32_t lcd_ms_to_ticks(uint16_t ms)
+{
+    uint32_t ticks = (uint32_t) ms * (clk_get()->aclk >> 3) / 1000;
+
+    return ticks ? ticks : 1;
+}
+#endif
+
+#if LCD_USE_DELAY
+static volatile uint8_t lcd_delay_done;     // Set by the Timer_A0 ISR
+
+/***************************************************************
+ * @brief   Waits in LPM3 for a number of milliseconds
+ * @param   "ms" - time to wait (0-65535)
+ * @return  None
+ *
+ * Timer_A0 counts ACLK / 8 in up mode and wakes the CPU with its
+ * CCR0 interrupt, in pieces of at most 0x10000 counts.  The
+ * delay is the same at every DCO setting, and the CPU clock is
+ * stopped for all of it, unlike __delay_cycles().
+ *
+ * Interrupts are enabled while the CPU sleeps; the caller's GIE
+ * state is restored on return.
+ **************************************************************/
+void lcd_delay_ms(uint16_t ms)
+{
+    //----------------------------------------------------------------------------------|
+    uint32_t ticks, step;                       // Remaining counts, counts this piece  |
+    uint16_t gie = __get_SR_register() & GIE;   // Caller's interrupt state             |
+                                                ////////////////////////////////////////|
+    if (ms == 0)                                //                                      |
+        return;                                 //                                      |
+    for (ticks = lcd_ms_to_ticks(ms); ticks != 0; ticks -= step)                    //  |
+    {                                           //                                      |
+        step = (ticks > 0x10000) ? 0x10000 : ticks; // Clamp to the 16-bit CCR0 range   |
+        lcd_delay_done = 0;                     //                                      |
+        TA0CCR0 = (uint16_t) (step - 1);        // Period                               |
+        TA0CCTL0 = CCIE;                        // CCR0 interrupt                       |
+        TA0CTL = TASSEL__ACLK | ID__8 | MC__UP | TACLR; // ACLK/8, up mode              |
+                                                //                                      |
+        __disable_interrupt();                  // Test the flag with interrupts off so |
+        while (!lcd_delay_done)                 // the ISR cannot slip in between the   |
+        {                                       // test and the sleep.                  |
+            __bis_SR_register(LPM3_bits | GIE); //                                      |
+            __disable_interrupt();              //                                      |
+        }                                       //                                      |
+        if (gie)                                // Back to the caller's GIE             |
+            __enable_interrupt();               //                                      |
+    }                                           //                                      |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Timer_A0 CCR0 ISR; ends a piece of lcd_delay_ms()
+ * @param   None
+ * @return  None
+ **************************************************************/
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=TIMER0_A0_VECTOR
+__interrupt void delay_isr(void)
+#elif defined(__GNUC__) && defined(__MSP430__)
+void __attribute__ ((interrupt(TIMER0_A0_VECTOR))) delay_isr(void)
+#else
+void delay_isr(void)
+#endif
+{
+    TA0CTL = MC__STOP;
+    TA0CCTL0 = 0;
+    lcd_delay_done = 1;
+    __bic_SR_register_on_exit(LPM3_bits);
+}
+#endif /* LCD_USE_DELAY */
+
+/****************************************************************
+ * Scroll engine
+ ***************************************************************/
+#if LCD_USE_SCROLL
+typedef struct{
+    lcd_getc_t getc;            // Character source
+    void *arg;                  // Source argument
+    const char *str;            // Cursor of the string source
+    char win[6];                // Sliding window (ring buffer)
+    uint8_t head;               // Oldest character in the window
+    uint8_t pad;                // Blanks shifted in after the text
+    uint16_t step_ms;           // Time per step
+    volatile uint8_t busy;      // Scroll in progress
+    lcd_callback_t done;        // Completion callback
+} ctxScroll_t;
+
+static ctxScroll_t scroll;
+
+/***************************************************************
+ * @brief   Character source for scroll_start(); walks a C string
+ *          in RAM or FRAM in place
+ * @param   "arg" - unused
+ * @return  Next character, or SCROLL_EOF at the terminator
+ **************************************************************/
+static int scroll_getc_str(void *arg)
+{
+    (void) arg;
+    if (*scroll.str == '\0')
+        return SCROLL_EOF;
+    return (unsigned char) *scroll.str++;
+}
+
+/***************************************************************
+ * @brief   Shifts the next character into the sliding window
+ * @param   None
+ * @return  None
+ *
+ * Once the source reports SCROLL_EOF it is not called again and
+ * blanks are shifted in instead, until the text has left the
+ * display.
+ **************************************************************/
+static void scroll_shift(void)
+{
+    //----------------------------------------------------------------------------------|
+    int c = SCROLL_EOF;                         // Next character                       |
+                                                ////////////////////////////////////////|
+    if (scroll.pad == 0)                        // Source not exhausted yet             |
+        c = scroll.getc(scroll.arg);            //                                      |
+    if (c == SCROLL_EOF)                        // Trailing blank                       |
+    {                                           //                                      |
+        c = ' ';                                //                                      |
+        scroll.pad++;                           //                                      |
+    }                                           //                                      |
+    scroll.win[scroll.head] = (char) c;         // Overwrite the oldest character and   |
+    if (++scroll.head == 6)                     // advance the ring                     |
+        scroll.head = 0;                        //                                      |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Draws the sliding window into the shadow framebuffer
+ * @param   None
+ * @return  None
+ **************************************************************/
+static void scroll_render(void)
+{
+    //----------------------------------------------------------------------------------|
+    uint8_t p, w = scroll.head;                 // Display position, window index       |
+                                                ////////////////////////////////////////|
+    for (p = 0; p < 6; p++)                     // Oldest character goes to LCD_A1      |
+    {                                           //                                      |
+        lcd_put_char(scroll.win[w],             //                                      |
+                     lcd_positions[p]);         //                                      |
+        if (++w == 6)                           //                                      |
+            w = 0;                              //                                      |
+    }                                           //                                      |
+    lcd_commit();                               // One commit per scroll step           |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Returns the Timer_A1 CCR0 value for a scroll step
+ * @param   "step_ms" - time per step in ms
+ * @return  ACLK / 8 counts minus one, clamped to 16 bits
+ **************************************************************/
+static uint16_t scroll_period(uint16_t step_ms)
+{
+    uint32_t ticks = lcd_ms_to_ticks(step_ms);
+
+    if (ticks > 0x10000)
+        ticks = 0x10000;
+    return (uint16_t) (ticks - 1);
+}
+
+/***************************************************************
+ * @brief   Starts scrolling text from a character source and
+ *          returns immediately
+ * @param   "getc"    - returns the next character on each call,
+ *                      or SCROLL_EOF when the text ends
+ *          "arg"     - passed to "getc"
+ *          "step_ms" - time each step is shown in ms (1-16000)
+ * @return  None
+ *
+ * Only a six-character window is kept, so text of any length,
+ * including text generated on the fly (e.g. log lines), scrolls
+ * in constant memory and without the heap.  "getc" is called
+ * once per step from the Timer_A1 ISR and must not block.
+ *
+ * Timer_A1 (ACLK / 8, up mode) advances one column per CCR0
+ * interrupt, so the CPU can sit in LPM3 between steps.  The
+ * step is derived from the ACLK recorded by clk_init(), so it
+ * does not depend on the DCO setting.  When
+ * the text has left the display and one blank step has elapsed,
+ * the timer stops, scroll_busy() returns 0, the callback set with
+ * scroll_set_callback() runs, and the CPU is woken from
+ * low-power mode.
+ *
+ * NOTE: The scroll ISR draws into the shadow framebuffer, so the
+ * application should not draw on the LCD while it is running.
+ **************************************************************/
+void scroll_start_stream(lcd_getc_t getc, void *arg, uint16_t step_ms)
+{
+    //----------------------------------------------------------------------------------|
+    TA1CTL = MC__STOP | TACLR;                  // Stop and reset a running scroll      |
+    TA1CCTL0 = 0;                               //                                      |
+                                                ////////////////////////////////////////|
+    scroll.getc = getc;                         // Load scroll context                  |
+    scroll.arg = arg;                           //                                      |
+    memset(scroll.win, ' ', sizeof(scroll.win));// Text enters from the right of a      |
+    scroll.head = 0;                            // blank display                        |
+    scroll.pad = 0;                             //                                      |
+    scroll.step_ms = step_ms;                   //                                      |
+    scroll.busy = 1;                            //                                      |
+    scroll_render();                            // First step is shown right away       |
+                                                ////////////////////////////////////////|
+    TA1CCR0 = scroll_period(step_ms);           // Period                               |
+    TA1CCTL0 = CCIE;                            // CCR0 interrupt                       |
+    TA1CTL = TASSEL__ACLK | ID__8 | MC__UP | TACLR; // ACLK/8, up mode                  |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Starts scrolling a string and returns immediately
+ * @param   "msg"     - string to scroll; may live in RAM or
+ *                      FRAM and must stay valid until the scroll
+ *                      completes.  It is read in place, one
+ *                      character per step.
+ *          "step_ms" - time each step is shown in ms (1-16000)
+ * @return  None
+ *
+ * A running scroll is stopped before its string is replaced, so
+ * its ISR cannot read the new string half set up.
+ **************************************************************/
+void scroll_start(const char *msg, uint16_t step_ms)
+{
+    scroll_stop();
+    scroll.str = msg;
+    scroll_start_stream(scroll_getc_str, 0, step_ms);
+}
+
+/***************************************************************
+ * @brief   Stops a running scroll without calling the callback
+ * @param   None
+ * @return  None
+ **************************************************************/
+void scroll_stop(void)
+{
+    TA1CTL = MC__STOP;
+    TA1CCTL0 = 0;
+    scroll.busy = 0;
+}
+
+/***************************************************************
+ * @brief   Returns whether a scroll is in progress
+ * @param   None
+ * @return  1 while scrolling, otherwise 0
+ **************************************************************/
+uint8_t scroll_busy(void)
+{
+    return scroll.busy;
+}
+
+/***************************************************************
+ * @brief   Sets the function called from the ISR when a scroll
+ *          completes
+ * @param   "cb" - callback, or 0 for none
+ * @return  None
+ **************************************************************/
+void scroll_set_callback(lcd_callback_t cb)
+{
+    scroll.done = cb;
+}
+
+/***************************************************************
+ * @brief   Timer_A1 CCR0 ISR; advances the scroll by one step
+ * @param   None
+ * @return  None
+ **************************************************************/
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=TIMER1_A0_VECTOR
+__interrupt void scroll_isr(void)
+#elif defined(__GNUC__) && defined(__MSP430__)
+void __attribute__ ((interrupt(TIMER1_A0_VECTOR))) scroll_isr(void)
+#else
+void scroll_isr(void)
+#endif
+{
+    //----------------------------------------------------------------------------------|
+    if (scroll.pad < 6)                         // Text still on display                |
+    {                                           //                                      |
+        scroll_shift();                         //                                      |
+        scroll_render();                        //                                      |
+    }                                           //                                      |
+    else if (scroll.pad == 6)                   // Blank step after the text            |
+    {                                           //                                      |
+        clear_lcd();                            //                                      |
+        scroll.pad++;                           //                                      |
+    }                                           //                                      |
+    else                                        // Done                                 |
+    {                                           //                                      |
+        scroll_stop();                          //                                      |
+        if (scroll.done)                        //                                      |
+            scroll.done();                      //                                      |
+        __bic_SR_register_on_exit(LPM3_bits);   // Wake up main                         |
+    }                                           //                                      |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Scrolls Message Across LCD
+ * @param   string "msg"
+ * @return  None
+ *
+ * Blocking wrapper around scroll_start().  Each step is shown
+ * for SCROLL_STEP_MS and the CPU waits in LPM3 until the scroll
+ * completes.  Interrupts are enabled while the CPU sleeps; the
+ * caller's GIE state is restored on return.
+ **************************************************************/
+void scroll_text(const char *msg)
+{
+    //----------------------------------------------------------------------------------|
+    uint16_t gie = __get_SR_register() & GIE;   // Caller's interrupt state             |
+                                                ////////////////////////////////////////|
+    scroll_start(msg, SCROLL_STEP_MS);          // Start the timer-driven scroll        |
+                                                //                                      |
+    __disable_interrupt();                      // Test the flag with interrupts off so |
+    while (scroll.busy)                         // the completing ISR cannot slip in    |
+    {                                           // between the test and the sleep.      |
+        __bis_SR_register(LPM3_bits | GIE);     // Sleep until the scroll completes     |
+        __disable_interrupt();                  //                                      |
+    }                                           //                                      |
+    if (gie)                                    // Back to the caller's GIE             |
+        __enable_interrupt();                   //                                      |
+    //----------------------------------------------------------------------------------|
+}
+#endif /* LCD_USE_SCROLL */
+
+/****************************************************************
+ * Text layout
+ ***************************************************************/
+typedef struct{
+    uint16_t cell[6];           // Laid out character words
+    uint8_t n;                  // Cells used
+    uint8_t deg;                // LCD_ESC_DEG seen
+} ctxText_t;
+
+/***************************************************************
+ * @brief   Adds one character to a text layout
+ * @param   "t" - layout
+ *          "c" - character or LCD_ESC_x escape
+ * @return  None
+ *
+ * '.' and ':' are folded into the decimal point or colon of the
+ * previous cell where the glass has one, and a leading '-' into
+ * NEG_SYM, so "12:34:56", "-12.345" and "3.14159" all fit.  The
+ * LCD_ESC_DP and LCD_ESC_COLON escapes fold the same way but
+ * never take a cell.  Characters past the sixth cell are
+ * dropped.
+ **************************************************************/
+static void lcd_text_putc(ctxText_t *t, char c)
+{
+    //----------------------------------------------------------------------------------|
+    uint8_t bit = 0;                            // Indicator the character folds into   |
+                                                ////////////////////////////////////////|
+    if (c == '\x01')                            // LCD_ESC_DEG                          |
+    {                                           //                                      |
+        t->deg = 1;                             //                                      |
+        return;                                 //                                      |
+    }                                           //                                      |
+    if (c == '-' && t->n == 0 && !t->cell[0])   // Leading minus: NEG_SYM on A1         |
+    {                                           //                                      |
+        t->cell[0] = neg_sym;                   //                                      |
+        return;                                 //                                      |
+    }                                           //                                      |
+    if ((c == '.' || c == '\x02') && t->n > 0)  // Decimal point of the previous cell   |
+        bit = dec_pt;                           //                                      |
+    if ((c == ':' || c == '\x03') && t->n > 1)  // COL1/COL2 after A2/A4 (bit 2 of A1   |
+        bit = colon;                            // is the sign)                         |
+    if (bit && (lcd_punct[t->n - 1] & bit) &&   // Fold if the previous cell has the    |
+        !(t->cell[t->n - 1] & bit))             // indicator and it is still unused     |
+    {                                           //                                      |
+        t->cell[t->n - 1] |= bit;               //                                      |
+        return;                                 //                                      |
+    }                                           //                                      |
+    if (c == '\x02' || c == '\x03')             // Escapes never take a cell            |
+        return;                                 //                                      |
+    if (t->n < 6)                               // Otherwise it takes a cell            |
+        t->cell[t->n++] |= lcd_glyph(c) & ~LCD_IND_BITS;                            //  |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Loads a laid out character word into a position,
+ *          taking over the indicators it folds in
+ * @param   "p"    - position number, 0 (LCD_A1) to 5 (LCD_A6)
+ *          "word" - glyph plus folded indicator bits
+ * @return  None
+ *
+ * Only the indicators the previous text or number lit and the
+ * ones this word folds in are written, so a dp, colon or sign
+ * lit with display_symbol() or lcd_symbols_set() is kept.
+ **************************************************************/
+static void lcd_text_cell(uint8_t p, uint16_t word)
+{
+    //----------------------------------------------------------------------------------|
+    uint8_t idx = lcd_positions[p] + 1;         // Byte holding the indicators          |
+                                                ////////////////////////////////////////|
+    lcd_put_cell(lcd_positions[p], word,        // Previous content and this word       |
+                 lcd_folded[idx] | (word & lcd_punct[p]));                          //  |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Writes a text layout to the six character positions
+ *          of the shadow framebuffer without committing it
+ * @param   "t" - layout
+ * @return  None
+ *
+ * Every position is written once and unused cells are blanked.
+ * A decimal point, colon, sign or DEG_SYM left by the previous
+ * text is cleared unless this text folds it in again.
+ **************************************************************/
+static void lcd_text_end(ctxText_t *t)
+{
+    //----------------------------------------------------------------------------------|
+    uint8_t p;                                  // Loop variable                        |
+    uint8_t idx = lcd_sym_table[DEG_SYM - 1].offset;    // DEG_SYM byte and bit         |
+    uint8_t deg = lcd_sym_table[DEG_SYM - 1].mask;      //                              |
+                                                ////////////////////////////////////////|
+    if (t->n == 0 && t->cell[0])                // A lone minus is drawn, not folded    |
+        t->cell[0] = lcd_glyph('-') & ~LCD_IND_BITS;                                //  |
+    for (p = 0; p < 6; p++)                     // Single pass over the positions       |
+        lcd_text_cell(p, t->cell[p]);           //                                      |
+    if (t->deg)                                 // Light DEG_SYM and own it             |
+    {                                           //                                      |
+        lcd_ind[idx] |= deg;                    //                                      |
+        lcd_folded[idx] |= deg;                 //                                      |
+    }                                           //                                      |
+    else if (lcd_folded[idx] & deg)             // Clear it if the last text lit it     |
+    {                                           //                                      |
+        lcd_ind[idx] &= ~deg;                   //                                      |
+        lcd_folded[idx] &= ~deg;                //                                      |
+    }                                           //                                      |
+    lcd_compose(idx);                           //                                      |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Lays out a string over the six character positions
+ *          of the shadow framebuffer without committing it
+ * @param   string "msg"
+ * @return  None
+ **************************************************************/
+static void lcd_put_text(const char *msg)
+{
+    //----------------------------------------------------------------------------------|
+    ctxText_t t;                                // Layout                               |
+                                                ////////////////////////////////////////|
+    memset(&t, 0, sizeof(t));                   //                                      |
+    while (*msg != '\0')                        // Layout pass                          |
+        lcd_text_putc(&t, *msg++);              //                                      |
+    lcd_text_end(&t);                           // Write pass                           |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Displays static message on LCD (six cells, with '.',
+ *          ':' and a leading '-' folded into the indicators)
+ * @param   string "msg"
+ * @return  None
+ **************************************************************/
+void display_msg(const char *msg)
+{
+    //----------------------------------------------------------------------------------|
+    lcd_put_text(msg);                          // Lay out and load the six cells       |
+    lcd_commit();                               // Write only the changed bytes         |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Displays a pre-rendered frame (see LCD_FRAME)
+ * @param   "frame" - six character words, usually a const
+ *                    table in FRAM
+ * @return  None
+ *
+ * The words go straight into the shadow framebuffer, with no
+ * glyph lookup or layout pass, and only the bytes that differ
+ * from the glass are written by the commit.
+ **************************************************************/
+void lcd_show_frame(const lcd_frame_t *frame)
+{
+    //----------------------------------------------------------------------------------|
+    uint8_t p;                                  // Loop variable                        |
+                                                ////////////////////////////////////////|
+    for (p = 0; p < 6; p++)                     // Indicators are taken over as by      |
+        lcd_text_cell(p, frame->cell[p]);       // display_msg                          |
+    lcd_commit();                               // Write only the changed bytes         |
+    //----------------------------------------------------------------------------------|
+}
+
+/****************************************************************
+ * LCD configuration
+ ***************************************************************/
+const lcd_config_t lcd_profile_default = {
+    LCDDIV__1 | LCDPRE__16,     // 256 Hz frame rate
+    1,                          // LP waveforms
+    LCD_BIAS_1_3,               //
+    VLCD_8,                     // Charge pump level
+    1,                          // Charge pump on
+    { LCD_PINS0, LCD_PINS1, LCD_PINS2 }
+};
+
+const lcd_config_t lcd_profile_low_power = {
+    LCDDIV__4 | LCDPRE__32,     // 32 Hz, the lowest rate without
+                                // visible flicker
+    1,                          // LP waveforms
+    LCD_BIAS_1_3,               //
+    VLCD_0,                     // VLCD from AVCC
+    0,                          // Charge pump off
+    { LCD_PINS0, LCD_PINS1, LCD_PINS2 }
+};
+
+/***************************************************************
+ * @brief   Programs the LCD_C timing, bias, voltage and pin
+ *          registers
+ * @param   "cfg" - configuration
+ * @return  None
+ *
+ * NOTE: LCDCCTL0 and LCDCPCTLx may only be changed while LCDON
+ * is cleared, which the caller must ensure.
+ **************************************************************/
+static void lcd_apply_config(const lcd_config_t *cfg)
+{
+    //---------------------------------------------------------|
+    uint16_t lcdctl0_ctx = 0;           // LCD off while the   |
+    uint16_t lcdcvctl_ctx = 0;          // module is set up    |
+                                        ///////////////////////|
+    lcdctl0_ctx |= lcd_frame_div(cfg->timing);  // Divider,    |
+                                        // prescaler for ACLK  |
+    lcdctl0_ctx |= LCD4MUX;             // 4 mux               |
+    if (cfg->lp)                        //                     |
+        lcdctl0_ctx |= LCDLP;           // LP waveforms        |
+    LCDCCTL0 = lcdctl0_ctx;             //                     |
+                                        //                     |
+    LCDCPCTL0 = cfg->pins[0];           // Enable segments     |
+    LCDCPCTL1 = cfg->pins[1];           //                     |
+    LCDCPCTL2 = cfg->pins[2];           //                     |
+                                        //                     |
+    lcdcvctl_ctx |= cfg->bias;          // Bias                |
+    lcdcvctl_ctx |= cfg->vlcd;          // VLCD source/level   |
+    if (cfg->charge_pump)               //                     |
+        lcdcvctl_ctx |= LCDCPEN;        // Charge pump         |
+    LCDCVCTL = lcdcvctl_ctx;            //                     |
+    LCDCCPCTL = LCDCPCLKSYNC;           //                     |
+    lcd_cfg = *cfg;                     // Saved in lcd_fram   |
+    lcd_unsaved = 1;                    //                     |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Clock change callback; keeps the frame rate, the
+ *          blink rate and a running scroll at their set values
+ * @param   "freq" - new clock frequencies (unused, the dividers
+ *                   are recomputed from clk_get())
+ * @return  None
+ *
+ * Registered by init_lcd() with clk_register(), so
+ * clk_set_profile() may move ACLK to another source or divider
+ * at any time.  When the LCDCCTL0 or LCDCBLKCTL dividers change,
+ * LCD_C is turned off while they are reprogrammed and back on if
+ * it was on, as in lcd_set_power_profile().
+ **************************************************************/
+static void lcd_clk_changed(const ctxClk_t *freq)
+{
+    //---------------------------------------------------------|
+    uint16_t timing = lcd_frame_div(lcd_cfg.timing);        // |
+    uint16_t blink = lcd_blink_div();   // Mode kept below     |
+    uint16_t on = LCDCCTL0 & LCDON;     // Current state       |
+                                        ///////////////////////|
+    (void) freq;                        //                     |
+    blink |= LCDCBLKCTL & LCDBLKMOD_3;  //                     |
+    if ((LCDCCTL0 & LCD_TIMING_BITS) != timing ||           // |
+        LCDCBLKCTL != blink)            //                     |
+    {                                   //                     |
+        LCDCCTL0 &= ~LCDON;             // Off to reprogram    |
+        LCDCCTL0 = (LCDCCTL0 & ~LCD_TIMING_BITS) | timing;  // |
+        LCDCBLKCTL = blink;             //                     |
+        if (on)                         //                     |
+            LCDCCTL0 |= LCDON;          //                     |
+    }                                   //                     |
+#if LCD_USE_SCROLL
+    if (scroll.busy)                    // Step time in ACLK   |
+        TA1CCR0 = scroll_period(scroll.step_ms);            // |
+#endif
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Initialize LCD
+ * @param   None
+ * @return  None
+ **************************************************************/
+void init_lcd(void)
+{
+    init_lcd_config(&lcd_profile_default);
+}
+
+/***************************************************************
+ * @brief   Initialize LCD with a given timing and power
+ *          configuration
+ * @param   "cfg" - e.g. &lcd_profile_default or
+ *          &lcd_profile_low_power
+ * @return  None
+ *
+ * The LCD memory is cleared and the last frame saved in FRAM,
+ * if any, repainted before the LCD is turned on; see
+ * lcd_restore().
+ **************************************************************/
+void init_lcd_config(const lcd_config_t *cfg)
+{
+    //---------------------------------------------------------|
+    ///////////////////////////////////////////////////////////|
+    //                                                         |
+    // NOTE: The MSP-EXP4306989 uses Segments S4, S6-S21,      |
+    // S27-S31 and S35-S39.  See SLAU627A at pg. 13            |
+    //                                                         |
+    // For LCD configuration see Chapter 36 of the TRM         |
+    //                                                         |
+    ///////////////////////////////////////////////////////////|
+    //---------------------------------------------------------|
+    LCDCCTL0 &= ~LCDON;                 // ensure LCD is off   |
+    lcd_apply_config(cfg);              //                     |
+                                        //                     |
+    LCDCMEMCTL = LCDCLRM | LCDCLRBM;    // clear memory and    |
+                                        // blinking memory     |
+    memset(lcd_text, 0, LCD_MEM_SIZE);  // Shadow matches the  |
+    memset(lcd_ind, 0, LCD_MEM_SIZE);   // cleared memory and  |
+    memset(lcd_folded, 0, LCD_MEM_SIZE);//                     |
+    memset(lcd_shadow, 0, LCD_MEM_SIZE);//                     |
+    memset(lcd_hw, 0, sizeof(lcd_hw));  //                     |
+    lcd_hw_stale = 0;                   //                     |
+    lcd_dirty[0] = 0;                   // LCDMEM on display   |
+    lcd_dirty[1] = 0;                   //                     |
+    lcd_page = 0;                       //                     |
+    lcd_dbuf_resume = 0;                //                     |
+    lcd_blink_stop();                   // No blinking         |
+    clk_register(lcd_clk_changed);      // Follow clock changes|
+    lcd_restore();                      // Last frame, if any  |
+                                        //                     |
+    LCDCCTL0 |= LCDON;                  // LCD on              |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Switches to another timing and power configuration
+ * @param   "cfg" - e.g. &lcd_profile_low_power
+ * @return  None
+ *
+ * The module is turned off while it is reprogrammed, as the TRM
+ * requires, and turned back on if it was on.  LCDMEM, LCDBMEM
+ * and blinking are kept, so the display only blanks for the
+ * few cycles the registers take.
+ **************************************************************/
+void lcd_set_power_profile(const lcd_config_t *cfg)
+{
+    //---------------------------------------------------------|
+    uint16_t on = LCDCCTL0 & LCDON;     // Current state       |
+                                        //                     |
+    LCDCCTL0 &= ~LCDON;                 // Off to reprogram    |
+    lcd_apply_config(cfg);              //                     |
+    if (on)                             //                     |
+        LCDCCTL0 |= LCDON;              //                     |
+    lcd_save();                         // Profile for restore |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Disables LCD
+ * @param   None
+ * @return  None
+ **************************************************************/
+void lcd_off(void)
+{
+    //---------------------------------------------------------|
+    ///////////////////////////////////////////////////////////|
+    //                                                         |
+    // NOTE: The MSP-EXP4306989 uses Segments S4, S6-S21,      |
+    // S27-S31 and S35-S39.  See SLAU627A at pg. 13            |
+    //                                                         |
+    // For LCD configuration see Chapter 36 of the TRM         |
+    //                                                         |
+    ///////////////////////////////////////////////////////////|
+    //---------------------------------------------------------|
+    LCDCCTL0 &= ~LCDON;             // Turns LCD off           |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Enables LCD
+ * @param   None
+ * @return  None
+ **************************************************************/
+void lcd_on(void)
+{
+    //---------------------------------------------------------|
+    ///////////////////////////////////////////////////////////|
+    //                                                         |
+    // NOTE: The MSP-EXP4306989 uses Segments S4, S6-S21,      |
+    // S27-S31 and S35-S39.  See SLAU627A at pg. 13            |
+    //                                                         |
+    // For LCD configuration see Chapter 36 of the TRM         |
+    //                                                         |
+    ///////////////////////////////////////////////////////////|
+    //---------------------------------------------------------|
+    LCDCCTL0 |= LCDON;            // Turns on LCD              |
+    //---------------------------------------------------------|
+}
+
+/****************************************************************
+ * Warm boot and LPMx.5
+ ***************************************************************/
+/***************************************************************
+ * @brief   Repaints the last frame flushed, from the FRAM copy
+ *          kept by lcd_save()
+ * @param   None
+ * @return  1 if a valid frame was found and drawn, otherwise 0
+ *
+ * Called by init_lcd() and init_lcd_config() on a cleared LCD,
+ * so after a reset or brownout the display shows the characters,
+ * symbols and blinking it had before, without waiting for the
+ * application to redraw them.  Call clear_lcd() afterwards for a
+ * blank start.
+ **************************************************************/
+uint8_t lcd_restore(void)
+{
+    //---------------------------------------------------------|
+    uint8_t i;                          //                     |
+                                        ///////////////////////|
+    if (!lcd_load())                    // No valid record     |
+        return 0;                       //                     |
+    if (lcd_blinking)                   // Blink mask back     |
+    {                                   // into LCDBMEM        |
+        for (i = 0; i < LCD_MEM_SIZE; i++)                  // |
+        {                               //                     |
+            if (lcd_blink[i])           //                     |
+                LCDBMEM[i] = lcd_blink[i];                  // |
+            lcd_hw[1][i] = lcd_blink[i];//                     |
+        }                               //                     |
+        LCDCBLKCTL = lcd_blink_div() | LCDBLKMOD_1;         // |
+    }                                   //                     |
+    lcd_flush();                        // Non-blank bytes     |
+    return 1;                           //                     |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Makes sure the FRAM copy is current before entering
+ *          LPMx.5
+ * @param   None
+ * @return  None
+ *
+ * Saves the display with lcd_save(), comparing every field even
+ * if nothing was drawn since the last save.  Call it right
+ * before lpm5_enter().
+ **************************************************************/
+void lcd_lpm5_save(void)
+{
+    lcd_unsaved = 1;
+    lcd_unsaved_bytes = LCD_DIRTY_ALL;
+    lcd_save();
+}
+
+/***************************************************************
+ * @brief   Takes the display over again after a wake-up from
+ *          LPMx.5, in place of init_lcd()
+ * @param   None
+ * @return  1 if the display was restored, 0 if no valid frame
+ *          was saved (call init_lcd() then)
+ *
+ * In LPM3.5 the LCD_C keeps its registers and memory and keeps
+ * driving the glass, so the library state is loaded from FRAM,
+ * LCDMEM and LCDBMEM are re-read and the frame on display is not
+ * touched.  If the module was stopped (LPM4.5), it is set up
+ * again from the saved configuration and the frame repainted.
+ *
+ * Call it after lpm5_restore() so ACLK is running.
+ **************************************************************/
+uint8_t lcd_lpm5_restore(void)
+{
+    //----------------------------------------------------------------------------------|
+    uint8_t i;                                  //                                      |
+                                                ////////////////////////////////////////|
+    if (lcd_fram.sum != lcd_fram_sum())         // Nothing saved                        |
+        return 0;                               //                                      |
+    if (!(LCDCCTL0 & LCDON))                    // LPM4.5: set the module up again      |
+    {                                           //                                      |
+        init_lcd_config(&lcd_fram.cfg);         // Repaints through lcd_restore()       |
+        return 1;                               //                                      |
+    }                                           //                                      |
+                                                ////////////////////////////////////////|
+    lcd_cfg = lcd_fram.cfg;                     // LPM3.5: the LCD kept running         |
+    lcd_load();                                 //                                      |
+    lcd_page = (LCDCMEMCTL & LCDDISP) ? 1 : 0;  //                                      |
+    for (i = 0; i < LCD_MEM_SIZE; i++)          // Learn what the banks hold; the       |
+    {                                           // flush below then writes nothing      |
+        lcd_hw[0][i] = LCDMEM[i];               // unless the frame was not flushed     |
+        lcd_hw[1][i] = LCDBMEM[i];              // before the save                      |
+    }                                           //                                      |
+    lcd_flush();                                //                                      |
+    clk_register(lcd_clk_changed);              // Follow clock changes                 |
+    return 1;                                   //                                      |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Converts a binary value to packed BCD without
+ *          division (double dabble)
+ * @param   "bin" - value, 0 to 999999
+ * @return  Six packed BCD digits, least significant in bits 3-0
+ *
+ * Each of the 20 input bits is shifted into the BCD value after
+ * adding 3 to every digit that is 5 or more.  The add-3 step is
+ * done on all six digits at once: adding 0x333333 sets bit 3 of
+ * exactly the digits that need the correction.  Leading zero
+ * bits are skipped, so small values convert in a few passes.
+ **************************************************************/
+static uint32_t lcd_bin2bcd(uint32_t bin)
+{
+    //----------------------------------------------------------------------------------|
+    uint32_t bcd = 0, t;                        // Result and correction mask           |
+    uint8_t i = 20;                             // Bits left (999999 < 2^20)            |
+                                                ////////////////////////////////////////|
+    bin <<= 12;                                 // Align bit 19 with bit 31             |
+    while (i && !(bin & 0x80000000UL))          // Skip leading zero bits               |
+    {                                           //                                      |
+        bin <<= 1;                              //                                      |
+        i--;                                    //                                      |
+    }                                           //                                      |
+    for (; i; i--)                              // Shift-and-add-3 loop                 |
+    {                                           //                                      |
+        t = (bcd + 0x333333UL) & 0x888888UL;    // Digits >= 5 ...                      |
+        bcd += (t >> 2) | (t >> 3);             // ... get 3 added                      |
+        bcd = (bcd << 1) | (bin >> 31);         // Shift in the next bit                |
+        bin <<= 1;                              //                                      |
+    }                                           //                                      |
+    return bcd;                                 //                                      |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Draws a number into the six positions of the shadow
+ *          framebuffer without committing it
+ * @param   "mag"   - magnitude
+ *          "neg"   - 1 to light the negative sign
+ *          "flags" - NUM_LEFT and/or NUM_ZEROPAD
+ *          "frac"  - digits after the decimal point (0-5)
+ * @return  None
+ *
+ * Each position's word, including its decimal point and the
+ * negative sign on LCD_A1, is composed before it is stored, so
+ * every position is written once.  Magnitudes above 999999
+ * show "------" as overflow indication.  Colons and the other
+ * indicators sharing the positions are left as they are.
+ **************************************************************/
+static void lcd_put_num(uint32_t mag, uint8_t neg, uint8_t flags, uint8_t frac)
+{
+    //----------------------------------------------------------------------------------|
+    uint32_t bcd = 0, t;                        // Packed digits                        |
+    uint8_t n = 6, first = 0, p;                // Digit count, first position, loop    |
+    uint16_t word;                              // Character word                       |
+                                                ////////////////////////////////////////|
+    if (mag <= NUM_MAX)                         // Fits in six digits                   |
+    {                                           //                                      |
+        bcd = lcd_bin2bcd(mag);                 //                                      |
+        n = 1;                                  // Count significant digits             |
+        for (t = bcd >> 4; t != 0; t >>= 4)     //                                      |
+            n++;                                //                                      |
+        if (n <= frac)                          // At least one digit before the dp     |
+            n = frac + 1;                       //                                      |
+        if (flags & NUM_ZEROPAD)                // Leading zeros fill all six cells     |
+            n = 6;                              //                                      |
+        first = (flags & NUM_LEFT) ? 0 : 6 - n; // Alignment                            |
+    }                                           //                                      |
+                                                ////////////////////////////////////////|
+    for (p = 6; p-- > 0; )                      // Right to left, so each digit is the  |
+    {                                           // lowest remaining nibble              |
+        if (mag > NUM_MAX)                      // Overflow                             |
+            word = lcd_glyph('-');              //                                      |
+        else if (p < first || p >= first + n)   // Blank                                |
+            word = 0;                           //                                      |
+        else                                    //                                      |
+        {                                       //                                      |
+            word = digits[bcd & 0x0F];          // Lowest remaining digit               |
+            bcd >>= 4;                          //                                      |
+            if (frac && p + frac == first + n - 1)  // Decimal point after the units    |
+                word |= dec_pt;                 // digit                                |
+        }                                       //                                      |
+        if (p == 0 && neg)                      // Negative sign on LCD_A1              |
+            word |= neg_sym;                    //                                      |
+        lcd_put_cell(lcd_positions[p], word,    // The number owns the dp and the sign  |
+                     (p < 5 ? dec_pt : 0) | (p == 0 ? neg_sym : 0));                //  |
+    }                                           //                                      |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Displays a signed 32-bit number
+ * @param   "in"    - value; -999999 to 999999 fit, the sign is
+ *                    shown with NEG_SYM
+ *          "flags" - NUM_RIGHT (default) or NUM_LEFT, optionally
+ *                    or'ed with NUM_ZEROPAD
+ * @return  None
+ *
+ * Only the six character positions, including their decimal
+ * points and the negative sign, are touched.
+ **************************************************************/
+void display_num32(int32_t in, uint8_t flags)
+{
+    if (in < 0)
+        lcd_put_num(0 - (uint32_t) in, 1, flags, 0);
+    else
+        lcd_put_num((uint32_t) in, 0, flags, 0);
+    lcd_commit();
+}
+
+/***************************************************************
+ * @brief   Displays an unsigned 32-bit number
+ * @param   "in"    - value; 0 to 999999 fit
+ *          "flags" - see display_num32()
+ * @return  None
+ **************************************************************/
+void display_unum32(uint32_t in, uint8_t flags)
+{
+    lcd_put_num(in, 0, flags, 0);
+    lcd_commit();
+}
+
+/***************************************************************
+ * @brief   Displays static number on LCD (limited to 6
+ *          digits)
+ * @param   input integer; negative values light NEG_SYM
+ * @return  None
+ *
+ * The whole display, including symbols, is cleared first.
+ **************************************************************/
+void display_num(int in)
+{
+    lcd_clear_shadow();
+    if (in < 0)
+        lcd_put_num(0 - (uint32_t) in, 1, NUM_RIGHT, 0);
+    else
+        lcd_put_num((uint32_t) in, 0, NUM_RIGHT, 0);
+    lcd_commit();
+}
+
+/***************************************************************
+ * @brief   Displays a fixed-point number
+ * @param   "value"       - scaled value, e.g. 2347 for 23.47
+ *          "frac_digits" - digits after the decimal point (0-5)
+ * @return  None
+ *
+ * The decimal point is lit on the units digit (DP1_SYM to
+ * DP5_SYM) and at least one digit is shown before it, so 5 with
+ * two fraction digits reads "0.05".  The sign is shown with
+ * NEG_SYM; values needing more than six digits show "------".
+ **************************************************************/
+void display_fixed(int32_t value, uint8_t frac_digits)
+{
+    if (frac_digits > 5)
+        frac_digits = 5;
+    if (value < 0)
+        lcd_put_num(0 - (uint32_t) value, 1, NUM_RIGHT, frac_digits);
+    else
+        lcd_put_num((uint32_t) value, 0, NUM_RIGHT, frac_digits);
+    lcd_commit();
+}
+
+/***************************************************************
+ * @brief   Splits a binary value into decimal digits without
+ *          division
+ * @param   "bin" - value
+ *          "d"   - receives up to 10 digits, most significant
+ *                  first
+ * @return  Number of digits (at least 1)
+ *
+ * Each digit is found by subtracting its power of ten, which is
+ * at most nine subtractions per digit.
+ **************************************************************/
+static uint8_t lcd_dec_digits(uint32_t bin, uint8_t *d)
+{
+    //----------------------------------------------------------------------------------|
+    static const uint32_t pow10[10] = {         // Powers of ten                        |
+        1000000000UL, 100000000UL, 10000000UL,  //                                      |
+        1000000UL, 100000UL, 10000UL,           //                                      |
+        1000UL, 100UL, 10UL, 1UL                //                                      |
+    };                                          //                                      |
+    uint8_t i = 0, n = 0, q;                    // Power index, digit count, digit      |
+                                                ////////////////////////////////////////|
+    while (i < 9 && bin < pow10[i])             // Skip leading zeros                   |
+        i++;                                    //                                      |
+    for (; i < 10; i++)                         //                                      |
+    {                                           //                                      |
+        for (q = 0; bin >= pow10[i]; q++)       // Subtract the power of ten            |
+            bin -= pow10[i];                    //                                      |
+        d[n++] = q;                             //                                      |
+    }                                           //                                      |
+    return n;                                   //                                      |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Displays a number auto-ranged to an engineering
+ *          suffix
+ * @param   "value" - mantissa
+ *          "exp10" - power of ten the mantissa is scaled by, so
+ *                    a reading of 1234 mV is (1234, -3)
+ * @return  None
+ *
+ * The value is shown with up to five significant digits on
+ * LCD_A1-LCD_A5, rounded, with trailing fraction zeros removed,
+ * and the suffix p, n, u, m, k, M, G or T on LCD_A6 (blank for
+ * units).  E.g. 1200 => "1.2k", (2347, -2) => "23.47".  Values
+ * above 999.99T saturate to "999.99T" and values below 1p are
+ * shown as 0, for any "exp10" from -128 to 127.  No floating
+ * point or division is used.
+ **************************************************************/
+void display_auto(int32_t value, int8_t exp10)
+{
+    //----------------------------------------------------------------------------------|
+    static const char suffix[9] = {             // 10^-12 ... 10^12                     |
+        'p', 'n', 'u', 'm', ' ', 'k', 'M', 'G', 'T'                                 //  |
+    };                                          //                                      |
+    uint32_t mag;                               // Magnitude                            |
+    uint8_t d[11];                              // Digits, most significant first       |
+    uint8_t n, ip, total, i, si = 4;            // Digits, integer digits, shown, suffix|
+    int16_t lead, e = 0;                        // Leading digit power, eng. exponent   |
+    uint16_t word;                              // Character word                       |
+                                                ////////////////////////////////////////|
+    mag = (value < 0) ? 0 - (uint32_t) value : (uint32_t) value;                    //  |
+    n = lcd_dec_digits(mag, d);                 //                                      |
+    lead = n - 1 + exp10;                       //                                      |
+    if (n > 5)                                  // Round to five significant digits     |
+    {                                           //                                      |
+        if (d[5] >= 5)                          //                                      |
+        {                                       //                                      |
+            for (i = 5; i-- > 0 && ++d[i] == 10; )  // Propagate the carry              |
+                d[i] = 0;                       //                                      |
+            if (d[0] == 0)                      // 99999.5 => 100000                    |
+            {                                   //                                      |
+                d[0] = 1;                       //                                      |
+                lead++;                         //                                      |
+            }                                   //                                      |
+        }                                       //                                      |
+        n = 5;                                  //                                      |
+    }                                           //                                      |
+                                                ////////////////////////////////////////|
+    while (lead - e >= 3 && si < 8)             // Engineering exponent: a multiple of  |
+    {                                           // 3 with 1 to 3 integer digits         |
+        e += 3;                                 //                                      |
+        si++;                                   //                                      |
+    }                                           //                                      |
+    while (lead - e < 0 && si > 0)              //                                      |
+    {                                           //                                      |
+        e -= 3;                                 //                                      |
+        si--;                                   //                                      |
+    }                                           //                                      |
+    if (mag == 0 || lead - e < 0)               // Zero, or below 1p                    |
+    {                                           //                                      |
+        d[0] = 0;                               //                                      |
+        n = 1;                                  //                                      |
+        lead = e = 0;                           //                                      |
+        si = 4;                                 //                                      |
+    }                                           //                                      |
+    else if (lead - e >= 3)                     // Above 999.99T: saturate              |
+    {                                           //                                      |
+        for (i = 0; i < 5; i++)                 //                                      |
+            d[i] = 9;                           //                                      |
+        n = 5;                                  //                                      |
+        lead = e + 2;                           //                                      |
+    }                                           //                                      |
+                                                ////////////////////////////////////////|
+    ip = lead - e + 1;                          // Integer digits (1-3)                 |
+    for (i = n; i < ip; i++)                    // Trailing integer zeros, e.g. 120     |
+        d[i] = 0;                               //                                      |
+    total = (n > ip) ? n : ip;                  //                                      |
+    while (total > ip && d[total - 1] == 0)     // Drop trailing fraction zeros         |
+        total--;                                //                                      |
+                                                ////////////////////////////////////////|
+    for (i = 0; i < 5; i++)                     // Mantissa right aligned on A1-A5      |
+    {                                           //                                      |
+        word = 0;                               //                                      |
+        if (i >= 5 - total)                     //                                      |
+        {                                       //                                      |
+            word = digits[d[i - (5 - total)]];  //                                      |
+            if (i - (5 - total) == ip - 1 && total > ip)    // Decimal point            |
+                word |= dec_pt;                 //                                      |
+        }                                       //                                      |
+        if (i == 0 && value < 0)                // Negative sign on LCD_A1              |
+            word |= neg_sym;                    //                                      |
+        lcd_put_cell(lcd_positions[i], word,    // The number owns the dp and the sign  |
+                     dec_pt | (i == 0 ? neg_sym : 0));                              //  |
+    }                                           //                                      |
+    lcd_put_char(suffix[si], LCD_A6);           // Engineering suffix                   |
+    lcd_commit();                               //                                      |
+    //----------------------------------------------------------------------------------|
+}
+
+/****************************************************************
+ * Formatted output
+ ***************************************************************/
+#define FMT_LEFT        (0x01)  // '-' flag
+#define FMT_ZERO        (0x02)  // '0' flag
+#define FMT_LONG        (0x04)  // 'l' length modifier
+#define FMT_PREC        (0x08)  // Precision given
+#define FMT_BAD         (0x10)  // Outside the supported subset
+
+#define FMT_ERROR       ('\x1F')    // Outside the font: all segments
+
+typedef struct{
+    uint8_t flags;              // FMT_x
+    uint8_t width;              // Minimum cells
+    uint8_t prec;               // Fraction digits, or %s length
+} ctxFmt_t;
+
+/***************************************************************
+ * @brief   Adds "count" copies of a character to a text layout
+ * @param   "t"     - layout
+ *          "c"     - character
+ *          "count" - repeat count
+ * @return  None
+ **************************************************************/
+static void lcd_text_fill(ctxText_t *t, char c, uint8_t count)
+{
+    while (count--)
+        lcd_text_putc(t, c);
+}
+
+/***************************************************************
+ * @brief   Adds a formatted number to a text layout
+ * @param   "t"    - layout
+ *          "f"    - conversion spec
+ *          "d"    - digits, most significant first
+ *          "n"    - digit count
+ *          "neg"  - 1 for a negative number
+ *          "hexa" - 'a' or 'A', glyph of digit 10
+ * @return  None
+ *
+ * A minus that would be the first character is folded into
+ * NEG_SYM ahead of any padding, so "%6d" of -42 reads like
+ * display_num().  Otherwise it takes a cell after the padding.
+ **************************************************************/
+static void lcd_fmt_num(ctxText_t *t, const ctxFmt_t *f, const uint8_t *d,
+                        uint8_t n, uint8_t neg, char hexa)
+{
+    //----------------------------------------------------------------------------------|
+    uint8_t fold, z, len, pad, k;               // NEG folded, leading zeros, cells,    |
+                                                // padding, digit index                 |
+                                                ////////////////////////////////////////|
+    fold = neg && t->n == 0 && !t->cell[0];     // Sign costs no cell                   |
+    z = (f->prec && n <= f->prec) ?             // At least one digit before the dp     |
+        f->prec + 1 - n : 0;                    //                                      |
+    len = z + n + (neg && !fold);               //                                      |
+    pad = (f->width > len) ? f->width - len : 0;                                    //  |
+                                                ////////////////////////////////////////|
+    if (fold)                                   //                                      |
+        lcd_text_putc(t, '-');                  //                                      |
+    if (!(f->flags & (FMT_LEFT | FMT_ZERO)))    // Right aligned with blanks            |
+        lcd_text_fill(t, ' ', pad);             //                                      |
+    if (neg && !fold)                           //                                      |
+        lcd_text_putc(t, '-');                  //                                      |
+    if ((f->flags & (FMT_LEFT | FMT_ZERO)) == FMT_ZERO)  // Right aligned with zeros    |
+        z += pad;                               //                                      |
+    for (k = 0; k < z + n; k++)                 // Digits, with the dp folded in        |
+    {                                           // ahead of the last "prec" digits      |
+        if (f->prec && k == z + n - f->prec)    //                                      |
+            lcd_text_putc(t, '.');              //                                      |
+        if (k < z)                              //                                      |
+            lcd_text_putc(t, '0');              //                                      |
+        else if (d[k - z] < 10)                 //                                      |
+            lcd_text_putc(t, '0' + d[k - z]);   //                                      |
+        else                                    //                                      |
+            lcd_text_putc(t, hexa + d[k - z] - 10);                                 //  |
+    }                                           //                                      |
+    if (f->flags & FMT_LEFT)                    // Left aligned                         |
+        lcd_text_fill(t, ' ', pad);             //                                      |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Adds a formatted string to a text layout
+ * @param   "t" - layout
+ *          "f" - conversion spec
+ *          "s" - string
+ * @return  None
+ **************************************************************/
+static void lcd_fmt_str(ctxText_t *t, const ctxFmt_t *f, const char *s)
+{
+    //----------------------------------------------------------------------------------|
+    uint8_t len, pad, max;                      // Characters, padding, limit           |
+                                                ////////////////////////////////////////|
+    max = (f->flags & FMT_PREC) ? f->prec : 0xFF;  // Precision limits the length       |
+    for (len = 0; len < max && s[len] != '\0'; len++)                               //  |
+        ;                                       //                                      |
+    pad = (f->width > len) ? f->width - len : 0;                                    //  |
+    if (!(f->flags & FMT_LEFT))                 //                                      |
+        lcd_text_fill(t, ' ', pad);             //                                      |
+    while (len--)                               //                                      |
+        lcd_text_putc(t, *s++);                 //                                      |
+    if (f->flags & FMT_LEFT)                    //                                      |
+        lcd_text_fill(t, ' ', pad);             //                                      |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Formats straight onto the six character positions
+ * @param   "fmt" - format; see the lcd_printf() box in liblcd.h
+ *          ...   - arguments
+ * @return  None
+ *
+ * There is no intermediate string: each character produced goes
+ * into the same layout as display_msg, so '.' and ':' fold into
+ * the indicators, and the positions are written in one pass at
+ * the end.  Numbers are split with lcd_dec_digits (no division),
+ * and nothing from the C library's printf is linked in.
+ *
+ * A flag, length or conversion outside the subset cannot tell
+ * how big its argument is, so formatting stops there: the cell
+ * it would have used (A6 if all six are taken) shows every
+ * segment, as lcd_glyph() does for an unknown character, and no
+ * later argument is read.
+ **************************************************************/
+void lcd_printf(const char *fmt, ...)
+{
+    //----------------------------------------------------------------------------------|
+    va_list ap;                                 // Arguments                            |
+    ctxText_t t;                                // Layout                               |
+    ctxFmt_t f;                                 // Conversion spec                      |
+    uint8_t d[10];                              // Digits, most significant first       |
+    uint8_t n, neg, i;                          // Digit count, sign, loop              |
+    uint32_t mag;                               // Magnitude                            |
+    int32_t v;                                  // Signed argument                      |
+    int a;                                      // '*' width or precision               |
+    char ch;                                    // %c argument                          |
+                                                ////////////////////////////////////////|
+    memset(&t, 0, sizeof(t));                   //                                      |
+    f.flags = 0;                                //                                      |
+    va_start(ap, fmt);                          //                                      |
+    for (; *fmt != '\0'; fmt++)                 //                                      |
+    {                                           //                                      |
+        if (*fmt != '%')                        // Literal                              |
+        {                                       //                                      |
+            lcd_text_putc(&t, *fmt);            //                                      |
+            continue;                           //                                      |
+        }                                       //                                      |
+        f.flags = 0;                            // Flags                                |
+        f.width = 0;                            //                                      |
+        f.prec = 0;                             //                                      |
+        for (fmt++; *fmt == '-' || *fmt == '0' || *fmt == '+' ||                    //  |
+                    *fmt == ' ' || *fmt == '#'; fmt++)                              //  |
+        {                                       //                                      |
+            if (*fmt == '-')                    //                                      |
+                f.flags |= FMT_LEFT;            //                                      |
+            else if (*fmt == '0')               //                                      |
+                f.flags |= FMT_ZERO;            //                                      |
+            else                                // '+', ' ' and '#' are not supported   |
+                f.flags |= FMT_BAD;             //                                      |
+        }                                       //                                      |
+        if (*fmt == '*')                        // Width from the arguments             |
+        {                                       //                                      |
+            a = va_arg(ap, int);                //                                      |
+            if (a < 0)                          // Negative: left aligned               |
+            {                                   //                                      |
+                f.flags |= FMT_LEFT;            //                                      |
+                a = -a;                         //                                      |
+            }                                   //                                      |
+            f.width = (a > 6) ? 6 : a;          // No wider than the glass              |
+            fmt++;                              //                                      |
+        }                                       //                                      |
+        for (; *fmt >= '0' && *fmt <= '9'; fmt++)  // Width in cells                    |
+            f.width = f.width * 10 + (*fmt - '0');                                  //  |
+        if (*fmt == '.')                        // Precision                            |
+        {                                       //                                      |
+            f.flags |= FMT_PREC;                //                                      |
+            if (*++fmt == '*')                  // From the arguments; negative means   |
+            {                                   // none, as in printf                   |
+                a = va_arg(ap, int);            //                                      |
+                if (a < 0)                      //                                      |
+                    f.flags &= ~FMT_PREC;       //                                      |
+                else                            //                                      |
+                    f.prec = (a > 9) ? 9 : a;   //                                      |
+                fmt++;                          //                                      |
+            }                                   //                                      |
+            for (; *fmt >= '0' && *fmt <= '9'; fmt++)                               //  |
+                f.prec = f.prec * 10 + (*fmt - '0');                                //  |
+        }                                       //                                      |
+        if (*fmt == 'h')                        // int anyway after promotion           |
+            fmt++;                              //                                      |
+        else if (*fmt == 'l')                   // 32-bit argument                      |
+        {                                       //                                      |
+            f.flags |= FMT_LONG;                //                                      |
+            fmt++;                              //                                      |
+        }                                       //                                      |
+        if (f.flags & FMT_BAD)                  // Stop before reading its argument     |
+            break;                              //                                      |
+                                                ////////////////////////////////////////|
+        switch (*fmt)                           //                                      |
+        {                                       //                                      |
+        case 'd':                               // Signed, "prec" fraction digits       |
+        case 'i':                               //                                      |
+            if (f.flags & FMT_LONG)             //                                      |
+                v = va_arg(ap, long);           //                                      |
+            else                                //                                      |
+                v = va_arg(ap, int);            //                                      |
+            neg = v < 0;                        //                                      |
+            mag = neg ? 0UL - (uint32_t) v : (uint32_t) v;                          //  |
+            n = lcd_dec_digits(mag, d);         //                                      |
+            lcd_fmt_num(&t, &f, d, n, neg, 'A');                                    //  |
+            break;                              //                                      |
+        case 'u':                               // Unsigned, "prec" fraction digits     |
+        case 'x':                               // Hexadecimal                          |
+        case 'X':                               //                                      |
+            if (f.flags & FMT_LONG)             //                                      |
+                mag = va_arg(ap, unsigned long);                                    //  |
+            else                                //                                      |
+                mag = va_arg(ap, unsigned int); //                                      |
+            if (*fmt == 'u')                    //                                      |
+                n = lcd_dec_digits(mag, d);     //                                      |
+            else                                //                                      |
+            {                                   //                                      |
+                for (n = 1; n < 8 && (mag >> (4 * n)); n++)                         //  |
+                    ;                           //                                      |
+                for (i = 0; i < n; i++)         //                                      |
+                    d[i] = (mag >> (4 * (n - 1 - i))) & 0x0F;                       //  |
+                f.prec = 0;                     //                                      |
+            }                                   //                                      |
+            ch = (*fmt == 'x') ? 'a' : 'A';     // Case of the hex digits               |
+            lcd_fmt_num(&t, &f, d, n, 0, ch);   //                                      |
+            break;                              //                                      |
+        case 'c':                               // Character                            |
+            ch = (char) va_arg(ap, int);        //                                      |
+            f.flags |= FMT_PREC;                //                                      |
+            f.prec = 1;                         //                                      |
+            lcd_fmt_str(&t, &f, &ch);           //                                      |
+            break;                              //                                      |
+        case 's':                               // String, "prec" limits the length     |
+            lcd_fmt_str(&t, &f, va_arg(ap, const char *));                          //  |
+            break;                              //                                      |
+        case '%':                               // Literal '%'                          |
+            lcd_text_putc(&t, '%');             //                                      |
+            break;                              //                                      |
+        default:                                // %f, %p, %o, %n, "ll", a lone '%' at  |
+            f.flags |= FMT_BAD;                 // the end, ...                         |
+            break;                              //                                      |
+        }                                       //                                      |
+        if (f.flags & FMT_BAD)                  //                                      |
+            break;                              //                                      |
+    }                                           //                                      |
+    va_end(ap);                                 //                                      |
+    if (f.flags & FMT_BAD)                      // Error trap where the output stopped  |
+    {                                           //                                      |
+        if (t.n == 6)                           //                                      |
+            t.cell[--t.n] = 0;                  //                                      |
+        lcd_text_putc(&t, FMT_ERROR);           //                                      |
+    }                                           //                                      |
+    lcd_text_end(&t);                           // Single pass over the positions       |
+    lcd_commit();                               // Write only the changed bytes         |
+    //----------------------------------------------------------------------------------|
+}
+
+/****************************************************************
+ * BCD counters
+ ***************************************************************/
+#if LCD_USE_CLOCK || LCD_USE_TIMER
+/***************************************************************
+ * @brief   Draws the digits of a packed BCD value that differ
+ *          from the value on display
+ * @param   "bcd"   - six digits, LCD_A1 in bits 23-20
+ *          "diff"  - "bcd" xor the value on display
+ *          "blank" - 1 to blank a leading zero on LCD_A1
+ * @return  None
+ *
+ * The digits are compared as BCD nibbles, so a counter step
+ * usually costs one position (LCD_A6) and one or two LCDMEM
+ * writes.  Indicators (colons, dp) are not redrawn.
+ **************************************************************/
+static void lcd_put_bcd(uint32_t bcd, uint32_t diff, uint8_t blank)
+{
+    //----------------------------------------------------------------------------------|
+    uint8_t p, d;                               //                                      |
+    uint16_t word;                              //                                      |
+                                                ////////////////////////////////////////|
+    for (p = 6; p-- > 0; bcd >>= 4, diff >>= 4) // Lowest digit first                  |
+    {                                           //                                      |
+        if (!(diff & 0x0F))                     // Digit unchanged                      |
+            continue;                           //                                      |
+        d = bcd & 0x0F;                         //                                      |
+        word = digits[d];                       //                                      |
+        if (p == 0 && d == 0 && blank)          // " 1:05:00"                           |
+            word = 0;                           //                                      |
+        lcd_put_word(lcd_positions[p], word);   //                                      |
+    }                                           //                                      |
+    //----------------------------------------------------------------------------------|
+}
+#endif
+
+/****************************************************************
+ * Clock mode
+ ***************************************************************/
+#if LCD_USE_CLOCK
+#define CLOCK_COLONS    (SYM_MASK(COLON1_SYM) | SYM_MASK(COLON2_SYM))
+
+typedef struct{
+    uint8_t flags;              // CLOCK_12H, CLOCK_BLINK
+    volatile uint8_t on;        // Clock mode running
+    uint32_t shown;             // 0x00HHMMSS in BCD on display
+    lcd_rtc_callback_t other;   // Gets the other RTC interrupts
+} ctxClock_t;
+
+static ctxClock_t lcd_time;
+
+/***************************************************************
+ * @brief   Converts a BCD hour to the 12-hour format
+ * @param   "h" - 0x00 to 0x23
+ * @return  0x01 to 0x12
+ **************************************************************/
+static uint8_t clock_12h(uint8_t h)
+{
+    if (h == 0x00)
+        return 0x12;
+    if (h > 0x12)
+    {
+        h -= 0x12;
+        if ((h & 0x0F) > 9)     // Borrow from the tens digit
+            h -= 6;
+    }
+    return h;
+}
+
+/***************************************************************
+ * @brief   Shows a time, redrawing only the digits that changed
+ * @param   "bcd" - 0x00HHMMSS
+ * @return  None
+ **************************************************************/
+static void clock_render(uint32_t bcd)
+{
+    lcd_put_bcd(bcd, bcd ^ lcd_time.shown, lcd_time.flags & CLOCK_12H);
+    lcd_time.shown = bcd;
+    lcd_commit();
+}
+
+/***************************************************************
+ * @brief   Reads the RTC_C time once
+ * @param   None
+ * @return  0x00HHMMSS in BCD
+ *
+ * Only consistent while RTCRDY is set, i.e. when the calendar
+ * registers are not being updated.
+ **************************************************************/
+static uint32_t clock_now(void)
+{
+    return ((uint32_t) RTCHOUR << 16) | ((uint16_t) RTCMIN << 8) | RTCSEC;
+}
+
+/***************************************************************
+ * @brief   Reads the RTC_C time at any moment
+ * @param   None
+ * @return  0x00HHMMSS in BCD
+ *
+ * Outside the RTCRDY window a read may catch the calendar in
+ * the middle of an update, so the registers are read until two
+ * consecutive reads match, as the RTC_C chapter of the TRM
+ * suggests.
+ **************************************************************/
+static uint32_t clock_read(void)
+{
+    uint32_t now = clock_now(), prev;
+
+    do
+    {
+        prev = now;
+        now = clock_now();
+    } while (now != prev);
+    return now;
+}
+
+/***************************************************************
+ * @brief   Shows an RTC_C time in the selected format
+ * @param   "now" - 0x00HHMMSS in BCD
+ * @return  None
+ **************************************************************/
+static void clock_update(uint32_t now)
+{
+    uint8_t h = (uint8_t) (now >> 16);
+
+    if (lcd_time.flags & CLOCK_12H)
+        h = clock_12h(h);
+    clock_render(((uint32_t) h << 16) | (now & 0xFFFF));
+}
+
+/***************************************************************
+ * @brief   Sets the RTC_C calendar time
+ * @param   "hour" - 0 to 23
+ *          "min"  - 0 to 59
+ *          "sec"  - 0 to 59
+ * @return  None
+ *
+ * The RTC is put in BCD calendar mode, which the clock mode
+ * needs, and keeps counting from LFXT in LPM3 and LPM3.5.  The
+ * date and the other RTCCTL1 bits (RTCTEV, ...) are left as
+ * they are.
+ **************************************************************/
+void lcd_clock_set(uint8_t hour, uint8_t min, uint8_t sec)
+{
+    //---------------------------------------------------------|
+    RTCCTL0_H = RTCKEY_H;               // Unlock RTC_C        |
+    RTCCTL1 |= RTCBCD | RTCHOLD | RTCMODE;  // Stop, BCD; the  |
+                                        // RTCTEV interval and |
+                                        // other bits are kept |
+    RTCHOUR = (uint8_t) lcd_bin2bcd(hour);  //                 |
+    RTCMIN = (uint8_t) lcd_bin2bcd(min);    //                 |
+    RTCSEC = (uint8_t) lcd_bin2bcd(sec);    //                 |
+    RTCCTL1 &= ~RTCHOLD;                // Run                 |
+    RTCCTL0_H = 0;                      // Lock RTC_C          |
+    if (lcd_time.on)                    // Show it now         |
+        clock_update(clock_read());     //                     |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Shows the RTC_C time as HH:MM:SS and keeps it
+ *          current from the RTC interrupt
+ * @param   "flags" - CLOCK_24H or CLOCK_12H, optionally or'ed
+ *                    with CLOCK_BLINK
+ * @return  None
+ *
+ * The RTC ready interrupt (once per second) redraws only the
+ * digits that changed; nothing else runs, so the CPU stays in
+ * LPM3 between seconds.  With CLOCK_BLINK the colons are
+ * blinked by the LCD_C at the lcd_blink_rate() rate, without
+ * CPU involvement.
+ *
+ * Set the time with lcd_clock_set() first.  The application
+ * should not draw on the digits while the clock mode runs.
+ * The other RTC_C interrupt enables are left as they are; see
+ * lcd_clock_set_callback().
+ **************************************************************/
+void lcd_clock_start(uint8_t flags)
+{
+    //---------------------------------------------------------|
+    uint8_t blink = (flags & CLOCK_BLINK) ? 1 : 0;          // |
+                                        ///////////////////////|
+    lcd_time.flags = flags;             //                     |
+    lcd_time.shown = 0xFFFFFFFFUL;      // Draw every digit    |
+    lcd_time.on = 1;                    //                     |
+    lcd_symbols_set(CLOCK_COLONS, 0);   // HH:MM:SS            |
+    lcd_blink_symbol(COLON1_SYM, blink);// Hardware blinking   |
+    lcd_blink_symbol(COLON2_SYM, blink);//                     |
+    clock_update(clock_read());         // Current time, drawn |
+                                        // before the first    |
+                                        // interrupt           |
+    RTCCTL0_H = RTCKEY_H;               // Unlock RTC_C        |
+    RTCCTL0_L |= RTCRDYIE;              // Once per second     |
+    RTCCTL0_H = 0;                      // Lock RTC_C          |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Stops the clock mode; the RTC keeps counting
+ * @param   None
+ * @return  None
+ **************************************************************/
+void lcd_clock_stop(void)
+{
+    //---------------------------------------------------------|
+    RTCCTL0_H = RTCKEY_H;               // Unlock RTC_C        |
+    RTCCTL0_L &= ~RTCRDYIE;             // No more updates     |
+    RTCCTL0_H = 0;                      // Lock RTC_C          |
+    lcd_time.on = 0;                    //                     |
+    lcd_blink_symbol(COLON1_SYM, 0);    //                     |
+    lcd_blink_symbol(COLON2_SYM, 0);    //                     |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Sets the handler for the RTC_C interrupts the clock
+ *          mode does not use
+ * @param   "cb" - called from the RTC ISR with the RTCIV value
+ *                 (alarm, interval, oscillator fault, ...), or 0
+ * @return  None
+ *
+ * The library owns RTC_VECTOR when LCD_USE_CLOCK is 1, so the
+ * application enables its RTC_C interrupts as usual and handles
+ * them here.  RTCIV__RTCRDYIFG is also passed on while the clock
+ * mode is stopped.
+ **************************************************************/
+void lcd_clock_set_callback(lcd_rtc_callback_t cb)
+{
+    lcd_time.other = cb;
+}
+
+/***************************************************************
+ * @brief   RTC_C ISR; shows the new time once per second and
+ *          passes every other interrupt to the callback
+ * @param   None
+ * @return  None
+ **************************************************************/
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=RTC_VECTOR
+__interrupt void clock_isr(void)
+#elif defined(__GNUC__) && defined(__MSP430__)
+void __attribute__ ((interrupt(RTC_VECTOR))) clock_isr(void)
+#else
+void clock_isr(void)
+#endif
+{
+    uint16_t iv = RTCIV;
+
+    if (iv == RTCIV__RTCRDYIFG && lcd_time.on)
+        clock_update(clock_now());
+    else if (iv != RTCIV__NONE && lcd_time.other)
+        lcd_time.other(iv);
+}
+#endif /* LCD_USE_CLOCK */
+
+/****************************************************************
+ * Stopwatch and countdown
+ ***************************************************************/
+#if LCD_USE_TIMER
+#define TIMER_HZ        (100)   // Hundredths of a second
+#define TIMER_SYMS      (SYM_MASK(COLON1_SYM) | SYM_MASK(DP4_SYM) | SYM_MASK(TMR_SYM))
+
+typedef struct{
+    volatile uint32_t time;     // 0x00MMSShh in BCD
+    uint32_t shown;             // Time on display
+    uint16_t period;            // ACLK ticks per 1/100 s, rounded down
+    uint8_t frac;               // Remainder, in 1/100 ticks
+    uint8_t acc;                // Accumulated remainder
+    uint8_t down;               // Counting down
+    uint8_t hold;               // Display frozen on a lap time
+    volatile uint8_t run;       // Timer running
+    lcd_callback_t alarm;       // Countdown reached zero
+} ctxTimer_t;
+
+static ctxTimer_t lcd_timer;
+
+/***************************************************************
+ * @brief   Adds 1/100 s to a MM:SS.hh BCD time
+ * @param   "t" - 0x00MMSShh
+ * @return  New time; 99:59.99 wraps to 00:00.00
+ *
+ * Each digit only carries into the next when it rolls over, so
+ * 90% of the steps end after the first test.
+ **************************************************************/
+static uint32_t timer_inc(uint32_t t)
+{
+    t++;
+    if ((t & 0x00000F) != 0x00000A)
+        return t;
+    t += 0x000006;                          // hh units -> tens
+    if ((t & 0x0000F0) != 0x0000A0)
+        return t;
+    t += 0x000060;                          // hh tens -> SS units
+    if ((t & 0x000F00) != 0x000A00)
+        return t;
+    t += 0x000600;                          // SS units -> tens
+    if ((t & 0x00F000) != 0x006000)
+        return t;
+    t += 0x00A000;                          // 60 s -> MM units
+    if ((t & 0x0F0000) != 0x0A0000)
+        return t;
+    t += 0x060000;                          // MM units -> tens
+    if ((t & 0xF00000) != 0xA00000)
+        return t;
+    return 0;
+}
+
+/***************************************************************
+ * @brief   Subtracts 1/100 s from a MM:SS.hh BCD time
+ * @param   "t" - 0x00MMSShh, not 0
+ * @return  New time
+ **************************************************************/
+static uint32_t timer_dec(uint32_t t)
+{
+    t--;
+    if ((t & 0x00000F) != 0x00000F)
+        return t;
+    t -= 0x000006;                          // Borrow from hh tens
+    if ((t & 0x0000F0) != 0x0000F0)
+        return t;
+    t -= 0x000060;                          // Borrow from SS units
+    if ((t & 0x000F00) != 0x000F00)
+        return t;
+    t -= 0x000600;                          // Borrow from SS tens
+    if ((t & 0x00F000) != 0x00F000)
+        return t;
+    t -= 0x00A000;                          // Borrow from MM units
+    if ((t & 0x0F0000) != 0x0F0000)
+        return t;
+    return t - 0x060000;                    // Borrow from MM tens
+}
+
+/***************************************************************
+ * @brief   Computes the Timer_A2 period from ACLK
+ * @param   None
+ * @return  None
+ *
+ * 100 Hz does not divide 32768 Hz, so the period alternates
+ * between "period" and "period" + 1 ticks to average out to
+ * exactly 1/100 s.
+ **************************************************************/
+static void timer_period(void)
+{
+    uint32_t aclk = clk_get()->aclk;
+
+    lcd_timer.period = (uint16_t) (aclk / TIMER_HZ);
+    lcd_timer.frac = (uint8_t) (aclk % TIMER_HZ);
+    lcd_timer.acc = 0;
+}
+
+/***************************************************************
+ * @brief   Clock change callback; reloads the Timer_A2 period
+ * @param   "freq" - new clock frequencies (unused)
+ * @return  None
+ **************************************************************/
+static void timer_clk_changed(const ctxClk_t *freq)
+{
+    (void) freq;
+    timer_period();
+}
+
+/***************************************************************
+ * @brief   Draws the counter if it changed and is not held
+ * @param   None
+ * @return  None
+ **************************************************************/
+static void timer_render(void)
+{
+    uint32_t t = lcd_timer.time;
+
+    if (lcd_timer.hold || t == lcd_timer.shown)
+        return;
+    lcd_put_bcd(t, t ^ lcd_timer.shown, 0);
+    lcd_timer.shown = t;
+    lcd_commit();
+}
+
+/***************************************************************
+ * @brief   Sets the stopwatch or countdown time and shows it
+ *          as MM:SS.hh with TMR_SYM
+ * @param   "min"  - 0 to 99
+ *          "sec"  - 0 to 59
+ *          "hsec" - hundredths, 0 to 99
+ * @return  None
+ **************************************************************/
+void lcd_timer_set(uint8_t min, uint8_t sec, uint8_t hsec)
+{
+    //---------------------------------------------------------|
+    lcd_timer.time = (lcd_bin2bcd(min) << 16) |             // |
+                     (lcd_bin2bcd(sec) << 8) |              // |
+                     lcd_bin2bcd(hsec);                     // |
+    lcd_timer.shown = 0xFFFFFFFFUL;     // Draw every digit    |
+    lcd_timer.hold = 0;                 //                     |
+    lcd_symbols_set(TIMER_SYMS, SYM_MASK(COLON2_SYM));      // |
+    timer_render();                     //                     |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Starts or resumes counting
+ * @param   "mode" - TIMER_UP (stopwatch) or TIMER_DOWN
+ *                   (countdown)
+ * @return  None
+ *
+ * Timer_A2 (ACLK, up mode) interrupts 100 times a second.  The
+ * ISR steps the BCD counter and writes only the digits that
+ * rolled over, so most steps cost one position; the CPU sleeps
+ * in LPM3 in between.  Counting continues from the current
+ * time, so lcd_timer_stop() followed by lcd_timer_start()
+ * pauses and resumes.
+ *
+ * A countdown stops at 00:00.00 and calls the function set with
+ * lcd_timer_set_alarm(), then wakes the CPU.
+ **************************************************************/
+void lcd_timer_start(uint8_t mode)
+{
+    //---------------------------------------------------------|
+    lcd_timer.down = (mode == TIMER_DOWN);                  // |
+    if (lcd_timer.down && lcd_timer.time == 0)  // Nothing to  |
+        return;                         // count down          |
+    timer_period();                     //                     |
+    clk_register(timer_clk_changed);    // Follow ACLK changes |
+    lcd_symbols_set(TIMER_SYMS, SYM_MASK(COLON2_SYM));      // |
+                                        //                     |
+    TA2CCR0 = lcd_timer.period - 1;     //                     |
+    TA2CCTL0 = CCIE;                    // CCR0 interrupt      |
+    TA2CTL = TASSEL__ACLK | MC__UP | TACLR;                 // |
+    lcd_timer.run = 1;                  //                     |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Pauses counting; the time stays on display
+ * @param   None
+ * @return  None
+ **************************************************************/
+void lcd_timer_stop(void)
+{
+    TA2CTL = MC__STOP;
+    TA2CCTL0 = 0;
+    lcd_timer.run = 0;
+    clk_unregister(timer_clk_changed);
+}
+
+/***************************************************************
+ * @brief   Freezes the display on a lap time while the timer
+ *          keeps counting, or releases it
+ * @param   "hold" - 1 to freeze on the current time, 0 to show
+ *                   the running time again
+ * @return  Current time as 0x00MMSShh (BCD)
+ *
+ * The time is 32 bits and the ISR steps it between the two word
+ * reads, so the snapshot and the lap render run with interrupts
+ * off; the caller's GIE is restored afterwards.
+ **************************************************************/
+uint32_t lcd_timer_lap(uint8_t hold)
+{
+    //---------------------------------------------------------|
+    uint16_t gie = __get_SR_register() & GIE;              //  |
+    uint32_t t;                         //                     |
+                                        //                     |
+    __disable_interrupt();              // ISR must not step   |
+    t = lcd_timer.time;                 // the time under us   |
+    lcd_timer.hold = 0;                 //                     |
+    timer_render();                     // Show the lap time   |
+    lcd_timer.hold = hold;              //                     |
+    if (gie)                            //                     |
+        __enable_interrupt();           //                     |
+    return t;                           //                     |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Returns the stopwatch or countdown time
+ * @param   None
+ * @return  0x00MMSShh (BCD)
+ *
+ * Reads the 32-bit time with interrupts off, like
+ * lcd_timer_lap(), so a step cannot tear the two words.
+ **************************************************************/
+uint32_t lcd_timer_get(void)
+{
+    uint16_t gie = __get_SR_register() & GIE;
+    uint32_t t;
+
+    __disable_interrupt();
+    t = lcd_timer.time;
+    if (gie)
+        __enable_interrupt();
+    return t;
+}
+
+/***************************************************************
+ * @brief   Sets the function called from the ISR when a
+ *          countdown reaches zero
+ * @param   "cb" - callback, or 0 for none
+ * @return  None
+ **************************************************************/
+void lcd_timer_set_alarm(lcd_callback_t cb)
+{
+    lcd_timer.alarm = cb;
+}
+
+/***************************************************************
+ * @brief   Timer_A2 CCR0 ISR; steps the stopwatch or countdown
+ * @param   None
+ * @return  None
+ **************************************************************/
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=TIMER2_A0_VECTOR
+__interrupt void timer_isr(void)
+#elif defined(__GNUC__) && defined(__MSP430__)
+void __attribute__ ((interrupt(TIMER2_A0_VECTOR))) timer_isr(void)
+#else
+void timer_isr(void)
+#endif
+{
+    //----------------------------------------------------------------------------------|
+    uint16_t period = lcd_timer.period;         //                                      |
+                                                ////////////////////////////////////////|
+    lcd_timer.acc += lcd_timer.frac;            // Spread the remainder of ACLK / 100   |
+    if (lcd_timer.acc >= TIMER_HZ)              //                                      |
+    {                                           //                                      |
+        lcd_timer.acc -= TIMER_HZ;              //                                      |
+        period++;                               //                                      |
+    }                                           //                                      |
+    TA2CCR0 = period - 1;                       // Next period                          |
+                                                ////////////////////////////////////////|
+    if (lcd_timer.down)                         // Step the counter                     |
+        lcd_timer.time = timer_dec(lcd_timer.time); //                                  |
+    else                                        //                                      |
+        lcd_timer.time = timer_inc(lcd_timer.time); //                                  |
+    timer_render();                             // Changed digits only                  |
+                                                ////////////////////////////////////////|
+    if (lcd_timer.down && lcd_timer.time == 0)  // Countdown done                       |
+    {                                           //                                      |
+        lcd_timer_stop();                       //                                      |
+        if (lcd_timer.alarm)                    //                                      |
+            lcd_timer.alarm();                  //                                      |
+        __bic_SR_register_on_exit(LPM3_bits);   // Wake up main                         |
+    }                                           //                                      |
     //----------------------------------------------------------------------------------|
 }
+#endif /* LCD_USE_TIMER */
@@ -49,10 +49,41 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
+#include "lcdfont.h"
 
 /****************************************************************
  * Defines
  ***************************************************************/
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Optional modules                                        |
+//                                                         |
+// A module that takes an interrupt vector is only built   |
+// when its LCD_USE_x macro is 1.  Set them for the whole  |
+// project on the compiler command line, e.g.              |
+// -DLCD_USE_DMA=1, so every file sees the same values.    |
+//                                                         |
+// The scroll engine and lcd_delay_ms() are built unless   |
+// set to 0, which frees their timer for the application.  |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#ifndef LCD_USE_SCROLL
+#define LCD_USE_SCROLL  (1)   // TIMER1_A0: scroll_x()     |
+#endif
+#ifndef LCD_USE_DELAY
+#define LCD_USE_DELAY   (1)   // TIMER0_A0: lcd_delay_ms() |
+#endif
+#ifndef LCD_USE_TIMER
+#define LCD_USE_TIMER   (0)   // TIMER2_A0: lcd_timer_x()  |
+#endif
+#ifndef LCD_USE_DMA
+#define LCD_USE_DMA     (0)   // DMA_VECTOR: lcd_set_dma() |
+#endif
+#ifndef LCD_USE_CLOCK
+#define LCD_USE_CLOCK   (0)   // RTC_VECTOR: lcd_clock_x() |
+#endif
+//---------------------------------------------------------|
+
 //---------------------------------------------------------|
 ///////////////////////////////////////////////////////////|
 // Character position memory locations                     |
@@ -79,12 +110,24 @@
 #define LCD_AT3         (13)   // AT1 begins at Pin S26    |
 //---------------------------------------------------------|
 
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Shadow framebuffer                                      |
+//                                                         |
+// All drawing functions write into a RAM copy of LCDMEM.  |
+// The copy covers LCD Memory 1 through 20, which holds    |
+// every position and symbol listed above.                 |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define LCD_MEM_SIZE    (20)  // Bytes mirrored in RAM     |
+//---------------------------------------------------------|
+
 //---------------------------------------------------------|
 ///////////////////////////////////////////////////////////|
 // Special Symbol list                                     |
 ///////////////////////////////////////////////////////////|
 //---------------------------------------------------------|
-#define NONE_SYM        (0x0)                              |
+#define NONE_SYM        (0x0)  // No symbol                |
 #define NEG_SYM         (0x1)  // Negative sign            |
 #define COLON1_SYM      (0x2)  // First colon LCD_A2       |
 #define COLON2_SYM      (0x3)  // Second colon LCD_A4      |
@@ -109,9 +152,225 @@
 #define B2_SYM          (0x16) // Battery 2                |
 #define B4_SYM          (0x17) // Battery 4                |
 #define B6_SYM          (0x18) // Battery 6                |
+#define LCD_SYM_COUNT   (0x18) // Last symbol number       |
+//---------------------------------------------------------|
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Symbol masks for lcd_symbols_set()                      |
+//                                                         |
+// Bit (n - 1) of a mask selects symbol number n, so       |
+// several symbols can be set and cleared in one call,     |
+// e.g. SYM_MASK(B1_SYM) | SYM_MASK(B2_SYM).               |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define SYM_MASK(sym)   (1UL << ((sym) - 1)) // Symbol n   |
+#define SYM_MASK_DP     (0x000000F8UL) // DP1 to DP5       |
+#define SYM_MASK_BAR    (0x00EE0000UL) // B1 to B6         |
+#define SYM_MASK_BATT   (0x00FF0000UL) // Bar, BATT and [] |
+#define SYM_MASK_ALL    (0x00FFFFFFUL) // Every symbol     |
+//---------------------------------------------------------|
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Battery gauge (lcd_battery_t)                           |
+//                                                         |
+// The gauge has BATT_LEVELS bars, lit B1 to B6.  Bar n    |
+// lights at thresh[n - 1] percent and goes out again      |
+// below thresh[n - 1] - hyst, so a reading that jitters   |
+// around a threshold does not flicker the bar.            |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define BATT_LEVELS     (6)    // B1 to B6                 |
+//---------------------------------------------------------|
+
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Blink rates for lcd_blink_rate()                        |
+//                                                         |
+// f_BLINK = ACLK / ((DIV + 1) * 2^(9 + PRE)), so with     |
+// ACLK = 32768 Hz the prescaler alone sets the rate.      |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define BLINK_4HZ       (LCDBLKPRE_4 | LCDBLKDIV_0) //     |
+#define BLINK_2HZ       (LCDBLKPRE_5 | LCDBLKDIV_0) //     |
+#define BLINK_1HZ       (LCDBLKPRE_6 | LCDBLKDIV_0) //     |
+#define BLINK_0_5HZ     (LCDBLKPRE_7 | LCDBLKDIV_0) //     |
+//---------------------------------------------------------|
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Scrolling                                               |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define SCROLL_STEP_MS  (250) // scroll_text() step time   |
+#define SCROLL_EOF      (-1)  // End of a scroll source    |
+//---------------------------------------------------------|
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Clock mode flags for lcd_clock_start()                  |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define CLOCK_24H       (0x00) // 00:00:00 to 23:59:59     |
+#define CLOCK_12H       (0x01) // 12:00:00 to 11:59:59     |
+#define CLOCK_BLINK     (0x02) // Colons blink             |
+//---------------------------------------------------------|
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Stopwatch and countdown modes for lcd_timer_start()     |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define TIMER_UP        (0x00) // Stopwatch                |
+#define TIMER_DOWN      (0x01) // Countdown to 00:00.00    |
+//---------------------------------------------------------|
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Number formatting flags                                 |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define NUM_RIGHT       (0x00) // Right aligned (default)  |
+#define NUM_LEFT        (0x01) // Left aligned             |
+#define NUM_ZEROPAD     (0x02) // Pad with leading zeros   |
+#define NUM_MAX         (999999UL) // Largest magnitude    |
+//---------------------------------------------------------|
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Pre-rendered frames (lcd_frame_t)                       |
+//                                                         |
+// LCD_FRAME builds the six cell words of a constant       |
+// screen at compile time from a string literal, e.g.      |
+//                                                         |
+//   static const lcd_frame_t ready = LCD_FRAME("READY "); |
+//                                                         |
+// The string must be exactly six characters; any other    |
+// length does not compile.  Const data is placed in       |
+// FRAM, and lcd_show_frame() copies the words to the      |
+// glass without a glyph lookup.                           |
+//                                                         |
+// For indicators, write the cells out as LCD_GLYPH(c)     |
+// or'ed with FRAME_DP or FRAME_COLON to light the ones    |
+// the position owns (see display_msg), e.g.               |
+//                                                         |
+//   { { LCD_GLYPH('C'), LCD_GLYPH('A'),                   |
+//       LCD_GLYPH('L') | FRAME_DP, ... } }                |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define FRAME_DP        (0x01) // DP1 to DP5, A1-A5        |
+#define FRAME_COLON     (0x04) // COL1/COL2 on A2/A4       |
+#define FRAME_NEG       (0x04) // NEG on A1                |
+//---------------------------------------------------------|
+#define LCD_FRAME_LEN(s)    (0 * sizeof(char[sizeof(s) == 7 ? 1 : -1]))
+#define LCD_FRAME(s)                                                       \
+    { { LCD_GLYPH((s)[0]) + LCD_FRAME_LEN(s),                              \
+        LCD_GLYPH((s)[1]), LCD_GLYPH((s)[2]), LCD_GLYPH((s)[3]),           \
+        LCD_GLYPH((s)[4]), LCD_GLYPH((s)[5]) } }
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// lcd_printf() formats                                    |
+//                                                         |
+// Conversions: %d %i %u %x %X %c %s and %%.               |
+// Flags: '-' (left aligned) and '0' (zero padded).        |
+// Width: cells, or '*' taking an int argument.            |
+// Length: 'l' for 32-bit arguments; 'h' is accepted.      |
+//                                                         |
+// The precision is NOT the C one.  On %d, %i and %u it is |
+// the number of fraction digits, so ("%.2d", 2347) shows  |
+// "23.47"; on %s it limits the length; '*' takes an int.  |
+//                                                         |
+// '.' and ':' fold into the indicators as with            |
+// display_msg(), and the escapes below are concatenated   |
+// into the format, e.g.                                   |
+//                                                         |
+//   lcd_printf("T%3d" LCD_ESC_DEG "C", t);                |
+//                                                         |
+// With GCC the argument types are checked against the     |
+// format at compile time, as for printf; the subset is    |
+// not.  Anything else ('+', ' ', '#', %f, %p, "ll", ...)  |
+// lights every segment of the next cell at run time and   |
+// ends the output there, before its argument is read.     |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define LCD_ESC_DEG     "\x01" // Light DEG_SYM            |
+#define LCD_ESC_DP      "\x02" // DP of the previous cell  |
+#define LCD_ESC_COLON   "\x03" // Colon of previous cell   |
+//---------------------------------------------------------|
+#if defined(__GNUC__)
+#define LCD_FORMAT(f, a) __attribute__ ((format (printf, f, a)))
+#else
+#define LCD_FORMAT(f, a)
+#endif
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// LCD timing and power (lcd_config_t)                     |
+//                                                         |
+// f_FRAME = f_LCD / (2 * mux) with                        |
+// f_LCD = ACLK / ((LCDDIVx + 1) * 2^LCDPREx).  With       |
+// ACLK = 32768 Hz and 4-mux:                              |
+//                                                         |
+//   LCDDIV__1 | LCDPRE__16  =>  256 Hz frame              |
+//   LCDDIV__4 | LCDPRE__32  =>   32 Hz frame              |
+//                                                         |
+// The timing is given for that ACLK; init_lcd() and       |
+// every clk_set_profile() rescale it to the ACLK in use,  |
+// as they do the blink rate.                              |
+//                                                         |
+// The charge pump is the largest LCD load; with it off    |
+// and VLCD_0 the segments are driven from AVCC.           |
+//                                                         |
+// LCD_PINSx are the segment lines wired on the            |
+// MSP-EXP430FR6989: S4, S6-S21, S27-S31 and S35-S39.      |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define LCD_BIAS_1_3    (0x00)  // 1/3 bias (default)      |
+#define LCD_BIAS_1_2    (LCD2B) // 1/2 bias                |
+#define LCD_PINS0       (0xFFD0) // LCDCPCTL0: S4, S6-S15  |
+#define LCD_PINS1       (0xF83F) // LCDCPCTL1: S16-S21,    |
+                                 // S27-S31                |
+#define LCD_PINS2       (0x00F8) // LCDCPCTL2: S35-S39     |
+//---------------------------------------------------------|
+
+/****************************************************************
+ * Typedefs and Structs
+ ***************************************************************/
+typedef void (*lcd_callback_t)(void);
+typedef int (*lcd_getc_t)(void *arg);
+typedef void (*lcd_rtc_callback_t)(uint16_t iv);
+typedef void (*lcd_dma_callback_t)(uint16_t iv);
+
+typedef struct{
+    uint16_t timing;            // LCDDIVx | LCDPREx, optionally LCDSSEL
+    uint8_t lp;                 // 1 for low-power waveforms (LCDLP)
+    uint8_t bias;               // LCD_BIAS_1_3 or LCD_BIAS_1_2
+    uint16_t vlcd;              // VLCD_x level, or VLCDEXT for an
+                                // external VLCD
+    uint8_t charge_pump;        // 1 to run the charge pump
+    uint16_t pins[3];           // LCDCPCTL0 to LCDCPCTL2
+} lcd_config_t;
+
+typedef struct{
+    uint8_t thresh[BATT_LEVELS];// Percent lighting B1 to B6, ascending
+    uint8_t hyst;               // Hysteresis in percent
+    uint8_t blink_empty;        // 1 to blink [] when no bar is lit
+} lcd_battery_t;
+
+typedef struct{
+    uint16_t cell[6];           // LCD_A1 to LCD_A6 character words
+} lcd_frame_t;
+
 /****************************************************************
  * Constants
  ***************************************************************/
+extern const uint16_t lcd_font[LCD_FONT_SIZE];
+extern const lcd_config_t lcd_profile_default;
+extern const lcd_config_t lcd_profile_low_power;
+extern const lcd_battery_t lcd_battery_default;
 extern const uint16_t digits[10];
 extern const uint16_t capletters[26];
 extern const uint16_t dec_pt;
@@ -143,13 +402,65 @@ void clear_lcd_mem(int position);
 void clear_lcd(void);
 void clear_timer_sym(void);
 void display_decimal_pt(void);
-void scroll_text(char*);
+#if LCD_USE_SCROLL
+void scroll_text(const char*);
+#endif
 void init_lcd(void);
-void display_msg(char*);
+void init_lcd_config(const lcd_config_t *cfg);
+void lcd_set_power_profile(const lcd_config_t *cfg);
+void lcd_save(void);
+uint8_t lcd_restore(void);
+void lcd_lpm5_save(void);
+uint8_t lcd_lpm5_restore(void);
+void display_msg(const char*);
+void lcd_show_frame(const lcd_frame_t *frame);
+void lcd_printf(const char *fmt, ...) LCD_FORMAT(1, 2);
 void lcd_off(void);
 void lcd_on(void);
 void display_num(int);
+void display_num32(int32_t in, uint8_t flags);
+void display_unum32(uint32_t in, uint8_t flags);
+void display_fixed(int32_t value, uint8_t frac_digits);
+void display_auto(int32_t value, int8_t exp10);
 void display_symbol(uint8_t sym);
 void clear_symbol(uint8_t sym);
+void lcd_symbols_set(uint32_t set_mask, uint32_t clear_mask);
+void lcd_blink_position(int position, uint8_t on);
+void lcd_blink_symbol(uint8_t sym, uint8_t on);
+void lcd_blink_rate(uint16_t rate);
+void lcd_battery_config(const lcd_battery_t *cfg);
+void lcd_battery_level(uint8_t percent);
+void lcd_flush(void);
+void lcd_set_autoflush(uint8_t on);
+void lcd_set_double_buffer(uint8_t on);
+#if LCD_USE_DMA
+void lcd_set_dma(uint8_t on, lcd_callback_t done);
+uint8_t lcd_dma_busy(void);
+void lcd_dma_set_callback(lcd_dma_callback_t cb);
+#endif
+#if LCD_USE_SCROLL
+void scroll_start(const char *msg, uint16_t step_ms);
+void scroll_start_stream(lcd_getc_t getc, void *arg, uint16_t step_ms);
+void scroll_stop(void);
+uint8_t scroll_busy(void);
+void scroll_set_callback(lcd_callback_t cb);
+#endif
+#if LCD_USE_DELAY
+void lcd_delay_ms(uint16_t ms);
+#endif
+#if LCD_USE_CLOCK
+void lcd_clock_set(uint8_t hour, uint8_t min, uint8_t sec);
+void lcd_clock_start(uint8_t flags);
+void lcd_clock_stop(void);
+void lcd_clock_set_callback(lcd_rtc_callback_t cb);
+#endif
+#if LCD_USE_TIMER
+void lcd_timer_set(uint8_t min, uint8_t sec, uint8_t hsec);
+void lcd_timer_start(uint8_t mode);
+void lcd_timer_stop(void);
+uint32_t lcd_timer_lap(uint8_t hold);
+uint32_t lcd_timer_get(void);
+void lcd_timer_set_alarm(lcd_callback_t cb);
+#endif
 
 #endif /* LIBLCD_H_ */
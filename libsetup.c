@@ -41,10 +41,120 @@
 
 #include "libsetup.h"
 
+/****************************************************************
+ * Defines
+ ***************************************************************/
+#define SELA_MASK       (SELA0 | SELA1 | SELA2)
+#define DIVA_MASK       (DIVA0 | DIVA1 | DIVA2)
+
+#define GPIO_PAIR(reg, i)   ((reg)[2 * (i)] | ((uint16_t) (reg)[2 * (i) + 1] << 8))
+
+/****************************************************************
+ * Port register writers for gpio_config().  "P" is the port pair
+ * (PA to PD, PJ) and "c" its ctxPort_t entry; registers still at
+ * their reset value of 0 are skipped.
+ ***************************************************************/
+#define GPIO_PORT(P, c)                                         \
+    do {                                                        \
+        P##OUT = (c)->out;                                      \
+        if ((c)->dir)                                           \
+            P##DIR = (c)->dir;                                  \
+        if ((c)->ren)                                           \
+            P##REN = (c)->ren;                                  \
+        if ((c)->sel0 & (c)->sel1)                              \
+            P##SELC = (c)->sel0 & (c)->sel1;                    \
+        if ((c)->sel0 & ~(c)->sel1)                             \
+            P##SEL0 = (c)->sel0;                                \
+        if ((c)->sel1 & ~(c)->sel0)                             \
+            P##SEL1 = (c)->sel1;                                \
+    } while (0)
+
+#define GPIO_IES(P, c)                                          \
+    do {                                                        \
+        if ((c)->ie)                                            \
+            P##IES = (c)->ies;                                  \
+    } while (0)
+
+#define GPIO_IE(P, c, wake)                                     \
+    do {                                                        \
+        if ((c)->ie)                                            \
+        {                                                       \
+            if (!(wake))                                        \
+                P##IFG = 0;                                     \
+            P##IE = (c)->ie;                                    \
+        }                                                       \
+    } while (0)
+
+#define GPIO_PORT_RESET     { 0, 0, 0, 0, 0, 0, 0 }
+
+/****************************************************************
+ * Typedefs and Structs
+ ***************************************************************/
+typedef struct{
+    uint16_t valid;                     // LPM5_VALID once saved
+    ctxPort_t ports[GPIO_PORTS];        // Port table
+    ctxClkCfg_t clk;                    // Clock setup
+} ctxLpm5_t;
+
+/****************************************************************
+ * Globals
+ ***************************************************************/
+static const uint32_t dco[] = {         // DCO frequency in Hz,
+                                        // indexed by DCO_xMHZ
+    1000000UL, 2670000UL, 3330000UL, 4000000UL, 5330000UL,
+    6670000UL, 8000000UL, 16000000UL, 21000000UL, 24000000UL
+};
+
+static const uint16_t dco_sel[] = {     // CSCTL1 value, indexed by
+    DCOFSEL_0,                          // DCO_xMHZ
+    DCOFSEL_1,
+    DCOFSEL_2,
+    DCOFSEL_3,
+    DCOFSEL_4,
+    DCOFSEL_5,
+    DCOFSEL_6,
+    DCOFSEL_4 | DCORSEL,
+    DCOFSEL_5 | DCORSEL,
+    DCOFSEL_6 | DCORSEL
+};
+
+static ctxClk_t clk_freq = {            // Reset state: DCO at
+    1000000UL, 1000000UL, LFXT_HZ       // 8 MHz / 8, ACLK from LFXT
+};
+
+static ctxClkCfg_t clk_cfg = {         // Last clk_config(), the
+    DCO_8MHZ, CLK_DCO, CLK_DIV_8,       // reset state until then
+    CLK_DCO, CLK_DIV_8, CLK_LFXT, CLK_DIV_1, LFXT_TIMEOUT_MS
+};
+
+static clk_notify_t clk_notify[CLK_MAX_NOTIFY];    // Clock consumers
+
+const ctxClkCfg_t clk_profile_run = {   // Bursts: 16 MHz MCLK
+    DCO_16MHZ, CLK_DCO, CLK_DIV_1, CLK_DCO, CLK_DIV_1,
+    CLK_LFXT, CLK_DIV_1, LFXT_TIMEOUT_MS
+};
+
+const ctxClkCfg_t clk_profile_idle = {  // Display only: 1 MHz MCLK
+    DCO_1MHZ, CLK_DCO, CLK_DIV_1, CLK_DCO, CLK_DIV_1,
+    CLK_LFXT, CLK_DIV_1, LFXT_TIMEOUT_MS
+};
+
+LIB_FRAM(lpm5_ctx)
+static ctxLpm5_t lpm5_ctx = {           // Context kept in FRAM
+    0,                                  // through LPMx.5
+    { GPIO_PORT_RESET, GPIO_PORT_RESET, GPIO_PORT_RESET,
+      GPIO_PORT_RESET, GPIO_PORT_RESET },
+    { 0, 0, 0, 0, 0, 0, 0, 0 }
+};
+
 /***************************************************************
  * @brief   Initializes GPIO for P1.1 and P2.3 use
  * @param   ctxGpio_t struct to set pins
  * @return  None
+ *
+ * Kept for existing callers; new code should describe the ports
+ * in a const ctxPort_t table and call gpio_config().  Pins with
+ * "pdir" cleared are outputs, and PJ.4/PJ.5 are given to LFXT.
  **************************************************************/
 void gpio_init(ctxGpio_t *inval)
 {
@@ -65,141 +175,404 @@ void gpio_init(ctxGpio_t *inval)
     //                                                            |
     //////////////////////////////////////////////////////////////|
     //------------------------------------------------------------|
-    P1DIR = 0xFF & ~inval->pdir[0];// Sets Port 1 pin directions  |
-    P2DIR = 0xFF & ~inval->pdir[1];// Sets Port 2 pin directions  |
-    P3DIR = 0xFF & ~inval->pdir[2];// Sets Port 3 pin directions  |
-    P4DIR = 0xFF & ~inval->pdir[3];// Sets Port 4 pin directions  |
-    P5DIR = 0xFF & ~inval->pdir[4];// Sets Port 5 pin directions  |
-    P6DIR = 0xFF & ~inval->pdir[5];// Sets Port 6 pin directions  |
-    P7DIR = 0xFF & ~inval->pdir[6];// Sets Port 7 pin directions  |
-    P8DIR = 0xFF & ~inval->pdir[7];// Sets Port 8 pin directions  |
+    ctxPort_t ports[GPIO_PORTS];   // Same setup as a port table  |
+    ctxPort_t *c;                  // Entry being filled          |
+    uint8_t i;                     //                             |
                                    //                             |
-    P1OUT = 0 | inval->pout[0];    // Sets Port 1 outputs         |
-    P2OUT = 0 | inval->pout[1];    // Sets Port 2 outputs         |
-    P3OUT = 0 | inval->pout[2];    // Sets Port 3 outputs         |
-    P4OUT = 0 | inval->pout[3];    // Sets Port 4 outputs         |
-    P5OUT = 0 | inval->pout[4];    // Sets Port 5 outputs         |
-    P6OUT = 0 | inval->pout[5];    // Sets Port 6 outputs         |
-    P7OUT = 0 | inval->pout[6];    // Sets Port 7 outputs         |
-    P8OUT = 0 | inval->pout[7];    // Sets Port 8 outputs         |
+    for (i = 0; i < GPIO_PJ; i++)  // P1 to P8 in pairs           |
+    {                              //                             |
+        c = &ports[i];             //                             |
+        c->dir = ~GPIO_PAIR(inval->pdir, i);                 //   |
+        c->out = GPIO_PAIR(inval->pout, i);                  //   |
+        c->ren = GPIO_PAIR(inval->pren, i);                  //   |
+        c->sel0 = GPIO_PAIR(inval->psel0, i);                //   |
+        c->sel1 = GPIO_PAIR(inval->psel1, i);                //   |
+        c->ies = 0;                // IRQs on P1 to P4 only       |
+        c->ie = 0;                 //                             |
+        if (i < GPIO_PC)           //                             |
+        {                          //                             |
+            c->ies = GPIO_PAIR(inval->pes, i);               //   |
+            c->ie = GPIO_PAIR(inval->pie, i);                //   |
+        }                          //                             |
+    }                              //                             |
+    c = &ports[GPIO_PJ];           //                             |
+    c->dir = 0;                    // PJ.4 and PJ.5 to XTO        |
+    c->out = 0;                    //                             |
+    c->ren = 0;                    //                             |
+    c->sel0 = BIT4 | BIT5;         //                             |
+    c->sel1 = 0;                   //                             |
+    c->ies = 0;                    //                             |
+    c->ie = 0;                     //                             |
                                    //                             |
-    P1REN = 0 | inval->pren[0];    // Sets Port 1 resistor setup  |
-    P2REN = 0 | inval->pren[1];    // Sets Port 2 resistor setup  |
-    P3REN = 0 | inval->pren[2];    // Sets Port 3 resistor setup  |
-    P4REN = 0 | inval->pren[3];    // Sets Port 4 resistor setup  |
-    P5REN = 0 | inval->pren[4];    // Sets Port 5 resistor setup  |
-    P6REN = 0 | inval->pren[5];    // Sets Port 6 resistor setup  |
-    P7REN = 0 | inval->pren[6];    // Sets Port 7 resistor setup  |
-    P8REN = 0 | inval->pren[7];    // Sets Port 8 resistor setup  |
-                                   //                             |
-    P1SEL0 = 0 | inval->psel0[0];  // Set P1 Mode Select0         |
-    P2SEL0 = 0 | inval->psel0[1];  // Set P2 Mode Select0         |
-    P3SEL0 = 0 | inval->psel0[2];  // Set P3 Mode Select0         |
-    P4SEL0 = 0 | inval->psel0[3];  // Set P4 Mode Select0         |
-    P5SEL0 = 0 | inval->psel0[4];  // Set P5 Mode Select0         |
-    P6SEL0 = 0 | inval->psel0[5];  // Set P6 Mode Select0         |
-    P7SEL0 = 0 | inval->psel0[6];  // Set P7 Mode Select0         |
-    P8SEL0 = 0 | inval->psel0[7];  // Set P8 Mode Select0         |
-                                   //                             |
-    P1SEL0 = 0 | inval->psel1[0];  // Set P1 Mode Select1         |
-    P2SEL0 = 0 | inval->psel1[1];  // Set P2 Mode Select1         |
-    P3SEL0 = 0 | inval->psel1[2];  // Set P3 Mode Select1         |
-    P4SEL0 = 0 | inval->psel1[3];  // Set P4 Mode Select1         |
-    P5SEL0 = 0 | inval->psel1[4];  // Set P5 Mode Select1         |
-    P6SEL0 = 0 | inval->psel1[5];  // Set P6 Mode Select1         |
-    P7SEL0 = 0 | inval->psel1[6];  // Set P7 Mode Select1         |
-    P8SEL0 = 0 | inval->psel1[7];  // Set P8 Mode Select1         |
-                                   //                             |
-    P1IE = 0 | inval->pie[0];      // IRQ Enable for Port 1       |
-    P2IE = 0 | inval->pie[1];      // IRQ Enable for Port 2       |
-    P3IE = 0 | inval->pie[2];      // IRQ Enable for Port 3       |
-    P4IE = 0 | inval->pie[3];      // IRQ Enable for Port 4       |
-                                   //                             |
-    P1IES = 0 | inval->pes[0];     // IRQ Transition for Port 1   |
-    P2IES = 0 | inval->pes[1];     // IRQ Transition for Port 2   |
-    P3IES = 0 | inval->pes[2];     // IRQ Transition for Port 3   |
-    P4IES = 0 | inval->pes[3];     // IRQ Transition for Port 4   |
-                                   //                             |
-    PJSEL0 |= BIT4;                // Set PJ.4 and PJ.5 to XTO    |
-    PJSEL0 |= BIT5;                //                             |
+    gpio_config(ports, 0);         // Cold start                  |
+    //------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Configures every port from a table
+ * @param   "ports" - GPIO_PORTS entries, indexed GPIO_PA to
+ *                    GPIO_PJ; may be const and live in FRAM
+ *          "wake"  - 1 after a wake-up from LPMx.5, 0 after any
+ *                    other reset
+ * @return  None
+ *
+ * The port registers are written 16 bits (two ports) at a time
+ * and only where the table differs from the reset state, so a
+ * board using few pins costs a handful of writes on every boot
+ * and every LPMx.5 wake-up.  PxOUT has no defined reset value
+ * and is always written.  The registers must still hold their
+ * reset values, which is the case after any reset.
+ *
+ * The order follows Chapter 12 of the TRM:
+ *
+ *  1. OUT, DIR, REN and the function select are set while the
+ *     pins are still locked by LOCKLPM5.  Pins selecting both
+ *     SEL0 and SEL1 are switched with PxSELC so they never pass
+ *     through another function.
+ *  2. PxIES is set; this may raise PxIFG.
+ *  3. LOCKLPM5 is cleared, which releases the pins.
+ *  4. PxIFG is cleared, except after an LPMx.5 wake-up where it
+ *     tells which pin woke the device and its ISR must run.
+ *  5. PxIE is set.
+ **************************************************************/
+void gpio_config(const ctxPort_t *ports, uint8_t wake)
+{
+    //------------------------------------------------------------|
+    GPIO_PORT(PA, &ports[GPIO_PA]);// Steps 1 and 2               |
+    GPIO_PORT(PB, &ports[GPIO_PB]);//                             |
+    GPIO_PORT(PC, &ports[GPIO_PC]);//                             |
+    GPIO_PORT(PD, &ports[GPIO_PD]);//                             |
+    GPIO_PORT(PJ, &ports[GPIO_PJ]);//                             |
+    GPIO_IES(PA, &ports[GPIO_PA]); //                             |
+    GPIO_IES(PB, &ports[GPIO_PB]); //                             |
                                    //                             |
     PM5CTL0 &= ~LOCKLPM5;          // Lock-in configurations      |
+                                   //                             |
+    GPIO_IE(PA, &ports[GPIO_PA], wake);     // Steps 4 and 5      |
+    GPIO_IE(PB, &ports[GPIO_PB], wake);     //                    |
     //------------------------------------------------------------|
 }
 
 /***************************************************************
- * @brief   Initializes clock to use XTO and sets DCO to 1MHz
- * @param   None
+ * @brief   Returns the frequency of a clock source
+ * @param   "src" - CLK_LFXT to CLK_MOD
+ *          "dco_hz" - DCO frequency
+ * @return  Frequency in Hz
+ **************************************************************/
+static uint32_t clk_src_hz(uint8_t src, uint32_t dco_hz)
+{
+    switch(src){
+        case CLK_LFXT:
+            return LFXT_HZ;
+        case CLK_VLO:
+            return VLO_HZ;
+        case CLK_LFMOD:
+            return LFMOD_HZ;
+        case CLK_DCO:
+            return dco_hz;
+        default:
+            return MODOSC_HZ;
+    }
+}
+
+/***************************************************************
+ * @brief   Returns the FRAM wait states needed at an MCLK
+ * @param   "mclk" - MCLK in Hz
+ * @return  NWAITS value for FRCTL0
+ *
+ * FRAM runs without wait states up to 8 MHz and needs one up to
+ * 16 MHz, the highest MCLK in the Datasheet.  Above that two are
+ * used, but MCLK should then be divided (e.g. DCO_24MHZ with
+ * CLK_DIV_2) and the DCO used at full speed only for SMCLK.
+ **************************************************************/
+static uint16_t clk_nwaits(uint32_t mclk)
+{
+    if (mclk > 16000000UL)
+        return NWAITS_2;
+    if (mclk > 8000000UL)
+        return NWAITS_1;
+    return NWAITS_0;
+}
+
+/***************************************************************
+ * @brief   Initializes clock to use XTO and sets the DCO
+ * @param   "clkset" - DCO_1MHZ to DCO_24MHZ
  * @return  None
+ *
+ * MCLK and SMCLK run from the DCO undivided and ACLK from LFXT,
+ * falling back to VLO if the crystal does not start within
+ * LFXT_TIMEOUT_MS.  See clk_config().
  **************************************************************/
 void clk_init(uint8_t clkset)
 {
+    ctxClkCfg_t cfg;
+
+    cfg.dco = clkset;
+    cfg.mclk_src = CLK_DCO;
+    cfg.mclk_div = CLK_DIV_1;
+    cfg.smclk_src = CLK_DCO;
+    cfg.smclk_div = CLK_DIV_1;
+    cfg.aclk_src = CLK_LFXT;
+    cfg.aclk_div = CLK_DIV_1;
+    cfg.lfxt_timeout_ms = LFXT_TIMEOUT_MS;
+    clk_config(&cfg);
+}
+
+/***************************************************************
+ * @brief   Starts LFXT and waits a bounded time for it
+ * @param   "timeout_ms" - start-up limit
+ *          "mclk"       - MCLK while polling, in Hz
+ * @return  1 if the crystal runs, 0 if it was turned off again
+ *          after the timeout
+ *
+ * The fault flags are polled every 1000 MCLK cycles, so the
+ * wait no longer hangs on a board without the crystal.
+ **************************************************************/
+static uint8_t clk_lfxt_start(uint16_t timeout_ms, uint32_t mclk)
+{
+    //---------------------------------------------------------|
+    uint32_t slices;                    // Polls left          |
+                                        //                     |
+    slices = (uint32_t) timeout_ms * (mclk / 1000) / 1000;  // |
+    CSCTL4 &= ~LFXTOFF;                 // Select XTO          |
+    do                                  //                     |
+    {                                   //                     |
+        CSCTL5 &= ~LFXTOFFG;            // Clear XT1 fault flag|
+        SFRIFG1 &= ~OFIFG;              //                     |
+        if (!(SFRIFG1 & OFIFG))         // Test oscillator     |
+            return 1;                   // fault flag          |
+        __delay_cycles(1000);           //                     |
+    } while (slices-- != 0);            //                     |
+                                        //                     |
+    CSCTL4 |= LFXTOFF;                  // No crystal          |
+    CSCTL5 &= ~LFXTOFFG;                //                     |
+    SFRIFG1 &= ~OFIFG;                  //                     |
+    return 0;                           //                     |
+    //---------------------------------------------------------|
+}
 
+/***************************************************************
+ * @brief   Configures the DCO, the clock sources and dividers,
+ *          and the FRAM wait states
+ * @param   ctxClkCfg_t struct with the clock setup
+ * @return  CLK_OK, or CLK_LFXT_FAIL if LFXT did not start and
+ *          the clocks using it were moved to VLO
+ *
+ * The wait states are raised before MCLK speeds up and lowered
+ * after it slows down, so FRAM is never accessed out of spec.
+ * As the Device Errata asks, the MCLK and SMCLK dividers are set
+ * to 4 while the DCO frequency changes.  ACLK is left running
+ * untouched until its final source is selected.
+ *
+ * LFXT is only started if a clock uses it, and it is given
+ * "lfxt_timeout_ms" to start so a board without the crystal
+ * still boots.  The frequencies in effect are recorded for
+ * clk_get().
+ **************************************************************/
+uint8_t clk_config(const ctxClkCfg_t *cfg)
+{
     //---------------------------------------------------------|
     ///////////////////////////////////////////////////////////|
-    // Settings for the GPIO can be found in Chapter 3 of      |
-    // of the TRM.                                             |
+    // Settings for the clock system can be found in Chapter 3 |
+    // of the TRM.  FRAM wait states are in Chapter 6.         |
     ///////////////////////////////////////////////////////////|
     //---------------------------------------------------------|
-    CSCTL0_H = CSKEY_H;         // Unlock CS Register          |
-    switch(clkset){             // Set the DCO Freq            |
-        case DCO_1MHZ:          //                             |
-            CSCTL1 = DCOFSEL_0; //                             |
-            CSCTL1 &= ~DCORSEL; //                             |
-            break;              //                             |
-        case DCO_2P67MHZ:       //                             |
-            CSCTL1 = DCOFSEL_1; //                             |
-            CSCTL1 &= ~DCORSEL; //                             |
-            break;              //                             |
-        case DCO_3P33MHZ:       //                             |
-            CSCTL1 = DCOFSEL_2; //                             |
-            CSCTL1 &= ~DCORSEL; //                             |
-            break;              //                             |
-        case DCO_4MHZ:          //                             |
-            CSCTL1 = DCOFSEL_3; //                             |
-            CSCTL1 &= ~DCORSEL; //                             |
-            break;              //                             |
-        case DCO_5P33MHZ:       //                             |
-            CSCTL1 = DCOFSEL_4; //                             |
-            CSCTL1 &= ~DCORSEL; //                             |
-            break;              //                             |
-        case DCO_6P67MHZ:       //                             |
-            CSCTL1 = DCOFSEL_5; //                             |
-            CSCTL1 &= ~DCORSEL; //                             |
-            break;              //                             |
-        case DCO_8MHZ:          //                             |
-            CSCTL1 = DCOFSEL_6; //                             |
-            CSCTL1 &= ~DCORSEL; //                             |
-            break;              //                             |
-        case DCO_16MHZ:         //                             |
-            CSCTL1 = DCOFSEL_4; //                             |
-            CSCTL1 |= DCORSEL;  //                             |
-            break;              //                             |
-        case DCO_21MHZ:         //                             |
-            CSCTL1 = DCOFSEL_5; //                             |
-            CSCTL1 |= DCORSEL;  //                             |
-            break;              //                             |
-        case DCO_24MHZ:         //                             |
-            CSCTL1 = DCOFSEL_6; //                             |
-            CSCTL1 |= DCORSEL;  //                             |
-            break;              //                             |
-        default:                //                             |
-            CSCTL1 = DCOFSEL_0; //                             |
-            CSCTL1 &= ~DCORSEL; //                             |
-            break;              //                             |
-    }                           //                             |
-    CSCTL2 = SELA__LFXTCLK;     // Set ACLK to XTO             |
-    CSCTL2 |= SELS__DCOCLK;     // Set SCLK to DCO             |
-    CSCTL2 |= SELM__DCOCLK;     // Set MCLK to DCO             |
-    CSCTL3 = DIVA__1;           // Divide ACLK by 1            |
-    CSCTL3 |= DIVS__1;          // Divide SCLK by 1            |
-    CSCTL3 |= DIVM__1;          // Divide MCLK by 1            |
-    CSCTL4 &= ~LFXTOFF;         // Select XTO                  |
-    do                          //                             |
-    {                           //                             |
-        CSCTL5 &= ~LFXTOFFG;    // Clear XT1 fault flag        |
-        SFRIFG1 &= ~OFIFG;      //                             |
-    } while (SFRIFG1 & OFIFG);  // Test oscillator fault flag  |
-    CSCTL0_H = 0;               // Lock CS registers           |
+    uint8_t d = cfg->dco;               // DCO setting         |
+    uint32_t f;                         // DCO frequency       |
+    uint8_t m = cfg->mclk_src;          // Sources, may fall   |
+    uint8_t s = cfg->smclk_src;         // back to VLO         |
+    uint8_t a = cfg->aclk_src;          //                     |
+    uint8_t result = CLK_OK;            //                     |
+    uint16_t nwaits;                    // FRAM wait states    |
+    uint16_t reg;                       // ACLK bits kept      |
+                                        ///////////////////////|
+    if (d > DCO_24MHZ)                  // Unknown setting     |
+        d = DCO_1MHZ;                   //                     |
+    f = dco[d];                         //                     |
+    if (a > CLK_LFMOD)                  // Not an ACLK source  |
+        a = CLK_LFXT;                   //                     |
+                                        //                     |
+    nwaits = clk_nwaits(clk_src_hz(m, f) >> cfg->mclk_div); // |
+    if (nwaits > (FRCTL0 & NWAITS_7))   // Slow FRAM down      |
+        FRCTL0 = FRCTLPW | nwaits;      // first               |
+                                        ///////////////////////|
+    CSCTL0_H = CSKEY_H;                 // Unlock CS Register  |
+    reg = CSCTL3 & DIVA_MASK;           // Errata: MCLK and    |
+    CSCTL3 = reg | DIVS__4 | DIVM__4;   // SMCLK from DCO / 4  |
+    reg = CSCTL2 & SELA_MASK;           // while the DCO       |
+    CSCTL2 = reg | SELS__DCOCLK | SELM__DCOCLK; // changes     |
+    CSCTL1 = dco_sel[d];                //                     |
+    __delay_cycles(60);                 // DCO settles         |
+                                        ///////////////////////|
+    if (m != CLK_LFXT && s != CLK_LFXT && a != CLK_LFXT)    // |
+        CSCTL4 |= LFXTOFF;              // Crystal not needed  |
+    else if (!clk_lfxt_start(cfg->lfxt_timeout_ms, f / 4))  // |
+    {                                   // No crystal: use VLO |
+        m = (m == CLK_LFXT) ? CLK_VLO : m;                  // |
+        s = (s == CLK_LFXT) ? CLK_VLO : s;                  // |
+        a = (a == CLK_LFXT) ? CLK_VLO : a;                  // |
+        result = CLK_LFXT_FAIL;         //                     |
+    }                                   //                     |
+                                        ///////////////////////|
+    CSCTL2 = m | (s << 4) | ((uint16_t) a << 8);            // |
+    CSCTL3 = cfg->mclk_div | (cfg->smclk_div << 4) |        // |
+             ((uint16_t) cfg->aclk_div << 8);               // |
+    CSCTL0_H = 0;                       // Lock CS registers   |
+                                        ///////////////////////|
+    clk_freq.mclk = clk_src_hz(m, f) >> cfg->mclk_div;      // |
+    clk_freq.smclk = clk_src_hz(s, f) >> cfg->smclk_div;    // |
+    clk_freq.aclk = clk_src_hz(a, f) >> cfg->aclk_div;      // |
+    FRCTL0 = FRCTLPW | clk_nwaits(clk_freq.mclk);           // |
+    clk_cfg = *cfg;                     // For lpm5_save()     |
+    return result;                      //                     |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Returns the clock frequencies set up by clk_init()
+ * @param   None
+ * @return  MCLK, SMCLK and ACLK in Hz
+ *
+ * Timed code should derive its counts from these values rather
+ * than assume a DCO setting, so that lowering MCLK to save power
+ * does not change any timing.
+ **************************************************************/
+const ctxClk_t *clk_get(void)
+{
+    return &clk_freq;
+}
+
+/***************************************************************
+ * @brief   Switches the clocks at runtime and tells every
+ *          registered consumer
+ * @param   ctxClkCfg_t struct, e.g. &clk_profile_run or
+ *          &clk_profile_idle
+ * @return  See clk_config()
+ *
+ * E.g. run sensor processing under clk_profile_run and drop to
+ * clk_profile_idle while only the LCD is refreshed.  Callbacks
+ * run in registration order after the new clocks are stable and
+ * can reload timer periods, baud rate dividers, etc.
+ **************************************************************/
+uint8_t clk_set_profile(const ctxClkCfg_t *cfg)
+{
+    uint8_t result, i;
+
+    result = clk_config(cfg);
+    for (i = 0; i < CLK_MAX_NOTIFY; i++)
+        if (clk_notify[i])
+            clk_notify[i](&clk_freq);
+    return result;
+}
+
+/***************************************************************
+ * @brief   Registers a function to call after clk_set_profile()
+ * @param   "cb" - callback; registering it again has no effect
+ * @return  1 on success, 0 if all CLK_MAX_NOTIFY slots are used
+ **************************************************************/
+uint8_t clk_register(clk_notify_t cb)
+{
+    uint8_t i, free = CLK_MAX_NOTIFY;
+
+    for (i = 0; i < CLK_MAX_NOTIFY; i++)
+    {
+        if (clk_notify[i] == cb)
+            return 1;
+        if (!clk_notify[i] && free == CLK_MAX_NOTIFY)
+            free = i;
+    }
+    if (free == CLK_MAX_NOTIFY)
+        return 0;
+    clk_notify[free] = cb;
+    return 1;
+}
+
+/***************************************************************
+ * @brief   Removes a function registered with clk_register()
+ * @param   "cb" - callback
+ * @return  None
+ **************************************************************/
+void clk_unregister(clk_notify_t cb)
+{
+    uint8_t i;
+
+    for (i = 0; i < CLK_MAX_NOTIFY; i++)
+        if (clk_notify[i] == cb)
+            clk_notify[i] = 0;
+}
+
+/***************************************************************
+ * @brief   Saves the port table and the clock setup to FRAM
+ *          before entering LPMx.5
+ * @param   "ports" - port table, as for gpio_config()
+ * @return  None
+ *
+ * The clock setup saved is the one of the last clk_config() or
+ * clk_set_profile() call.  Call lcd_lpm5_save() as well to keep
+ * the display.
+ **************************************************************/
+void lpm5_save(const ctxPort_t *ports)
+{
+    uint8_t i;
+
+    lpm5_ctx.valid = 0;                 // Invalid while written
+    for (i = 0; i < GPIO_PORTS; i++)
+        lpm5_ctx.ports[i] = ports[i];
+    lpm5_ctx.clk = clk_cfg;
+    lpm5_ctx.valid = LPM5_VALID;
+}
+
+/***************************************************************
+ * @brief   Restores the ports and the clocks after a wake-up
+ *          from LPMx.5
+ * @param   None
+ * @return  1 if the device woke from LPMx.5 and the context
+ *          saved by lpm5_save() was restored, 0 otherwise (the
+ *          caller then sets the board up from scratch)
+ *
+ * Call it first thing in main().  The ports are reconfigured
+ * before LOCKLPM5 is released, so the pins keep the levels they
+ * held during LPMx.5, and the interrupt flag of the pin that
+ * woke the device is kept for its ISR.
+ *
+ * NOTE: SYSRSTIV is read, which clears the reset cause it
+ * returns.
+ **************************************************************/
+uint8_t lpm5_restore(void)
+{
+    //---------------------------------------------------------|
+    if (SYSRSTIV != SYSRSTIV_LPM5WU)    // Not an LPMx.5 wake  |
+        return 0;                       //                     |
+    if (lpm5_ctx.valid != LPM5_VALID)   // Nothing saved       |
+        return 0;                       //                     |
+                                        //                     |
+    gpio_config(lpm5_ctx.ports, 1);     // Keep the wake IFG   |
+    clk_config(&lpm5_ctx.clk);          //                     |
+    return 1;                           //                     |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Enters LPM3.5 or LPM4.5
+ * @param   "mode" - LPM5_LPM3 to keep the LCD_C and RTC running
+ *                   from LFXT, LPM5_LPM4 to stop every clock
+ * @return  None; the device wakes up through a reset
+ *
+ * The core regulator is turned off, so RAM and the CPU registers
+ * are lost.  Save the context with lpm5_save() (and
+ * lcd_lpm5_save()) first and arm a wake-up source: a PA/PB pin
+ * interrupt, or the RTC in LPM3.5.
+ **************************************************************/
+void lpm5_enter(uint8_t mode)
+{
+    //---------------------------------------------------------|
+    PMMCTL0_H = PMMPW_H;                // Unlock PMM          |
+    PMMCTL0_L |= PMMREGOFF;             // Regulator off on    |
+    PMMCTL0_H = 0;                      // LPM entry           |
+                                        //                     |
+    if (mode == LPM5_LPM4)              //                     |
+        __bis_SR_register(LPM4_bits | GIE);                 // |
+    else                                //                     |
+        __bis_SR_register(LPM3_bits | GIE);                 // |
     //---------------------------------------------------------|
 }
@@ -44,6 +44,59 @@
 #define DCO_21MHZ       (0x08)
 #define DCO_24MHZ       (0x09)
 
+#define GPIO_PA         (0)         // P1 (low byte), P2 (high)
+#define GPIO_PB         (1)         // P3, P4
+#define GPIO_PC         (2)         // P5, P6
+#define GPIO_PD         (3)         // P7, P8
+#define GPIO_PJ         (4)         // PJ.0 to PJ.7
+#define GPIO_PORTS      (5)         // Entries in a port table
+
+#define CLK_LFXT        (0x00)      // Clock sources, in CSCTL2
+#define CLK_VLO         (0x01)      // encoding.  ACLK can only
+#define CLK_LFMOD       (0x02)      // use the first three.
+#define CLK_DCO         (0x03)      //
+#define CLK_MOD         (0x04)      //
+
+#define CLK_DIV_1       (0x00)      // Clock dividers, in CSCTL3
+#define CLK_DIV_2       (0x01)      // encoding
+#define CLK_DIV_4       (0x02)      //
+#define CLK_DIV_8       (0x03)      //
+#define CLK_DIV_16      (0x04)      //
+#define CLK_DIV_32      (0x05)      //
+
+#define LFXT_HZ         (32768UL)   // LFXT crystal, ACLK source
+#define VLO_HZ          (9400UL)    // Typical VLO, see Datasheet
+#define MODOSC_HZ       (5000000UL) // Typical MODOSC
+#define LFMOD_HZ        (MODOSC_HZ / 128)
+
+#define LFXT_TIMEOUT_MS (1000)      // Default LFXT start-up limit
+
+#define CLK_MAX_NOTIFY  (4)         // Clock change callbacks
+
+#define CLK_OK          (0x00)      // clk_config() results
+#define CLK_LFXT_FAIL   (0x01)      // LFXT fault, VLO used instead
+
+#define LPM5_LPM3       (0x00)      // lpm5_enter() modes: LCD and
+#define LPM5_LPM4       (0x01)      // RTC kept running, or all off
+#define LPM5_VALID      (0xC35A)    // Marks a saved FRAM context
+
+/****************************************************************
+ * FRAM variables.  LIB_FRAM(x) in front of the definition of a
+ * static variable "x" places it in FRAM, where it keeps its value
+ * through LPMx.5, resets and power cycles.  The initializer only
+ * applies when the device is programmed.
+ ***************************************************************/
+#define LIB_PRAGMA(x)   _Pragma(#x)
+#if defined(__TI_COMPILER_VERSION__)
+#define LIB_FRAM(x)     LIB_PRAGMA(PERSISTENT(x))
+#elif defined(__IAR_SYSTEMS_ICC__)
+#define LIB_FRAM(x)     __persistent
+#elif defined(__GNUC__) && defined(__MSP430__)
+#define LIB_FRAM(x)     __attribute__ ((persistent))
+#else
+#define LIB_FRAM(x)
+#endif
+
 /****************************************************************
  * Typedefs and Structs
  ***************************************************************/
@@ -58,10 +111,54 @@ typedef struct{
 
 } ctxGpio_t;
 
+typedef struct{
+    uint16_t dir;               // PxDIR, 1 = output
+    uint16_t out;               // PxOUT, pull-up where ren is set
+    uint16_t ren;               // PxREN
+    uint16_t sel0;              // PxSEL0
+    uint16_t sel1;              // PxSEL1
+    uint16_t ies;               // PxIES, PA and PB only
+    uint16_t ie;                // PxIE, PA and PB only
+} ctxPort_t;
+
+typedef struct{
+    uint32_t mclk;              // MCLK in Hz
+    uint32_t smclk;             // SMCLK in Hz
+    uint32_t aclk;              // ACLK in Hz
+} ctxClk_t;
+
+typedef struct{
+    uint8_t dco;                // DCO_1MHZ to DCO_24MHZ
+    uint8_t mclk_src;           // CLK_LFXT to CLK_MOD
+    uint8_t mclk_div;           // CLK_DIV_1 to CLK_DIV_32
+    uint8_t smclk_src;          // CLK_LFXT to CLK_MOD
+    uint8_t smclk_div;          // CLK_DIV_1 to CLK_DIV_32
+    uint8_t aclk_src;           // CLK_LFXT, CLK_VLO or CLK_LFMOD
+    uint8_t aclk_div;           // CLK_DIV_1 to CLK_DIV_32
+    uint16_t lfxt_timeout_ms;   // LFXT start-up limit
+} ctxClkCfg_t;
+
+typedef void (*clk_notify_t)(const ctxClk_t *freq);
+
+/****************************************************************
+ * Constants
+ ***************************************************************/
+extern const ctxClkCfg_t clk_profile_run;
+extern const ctxClkCfg_t clk_profile_idle;
+
 /****************************************************************
  * Forward Declarations
  ***************************************************************/
 void gpio_init(ctxGpio_t*);
+void gpio_config(const ctxPort_t*, uint8_t);
 void clk_init(uint8_t);
+uint8_t clk_config(const ctxClkCfg_t*);
+uint8_t clk_set_profile(const ctxClkCfg_t*);
+uint8_t clk_register(clk_notify_t);
+void clk_unregister(clk_notify_t);
+const ctxClk_t *clk_get(void);
+void lpm5_save(const ctxPort_t*);
+uint8_t lpm5_restore(void);
+void lpm5_enter(uint8_t);
 
 #endif /* LIBSETUP_H_ */
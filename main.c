@@ -39,6 +39,19 @@
 
 void set_board(void);
 
+/****************************************************************
+ * Board pin table: every pin an output driven low, except PJ.4
+ * and PJ.5 which go to the LFXT crystal.
+ ***************************************************************/
+static const ctxPort_t board[GPIO_PORTS] = {
+    /* dir     out     ren     sel0    sel1    ies     ie */
+    { 0xFFFF, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 },  // GPIO_PA
+    { 0xFFFF, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 },  // GPIO_PB
+    { 0xFFFF, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 },  // GPIO_PC
+    { 0xFFFF, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000 },  // GPIO_PD
+    { 0x0000, 0x0000, 0x0000, BIT4 | BIT5, 0x0000, 0x0000, 0x0000 },  // GPIO_PJ
+};
+
 int main(void)
 {
     //----------------------------------------------------------------------------------|
@@ -52,13 +65,13 @@ int main(void)
                                                     ////////////////////////////////////|
     for (i = 0x01; i <= 0x18; i++){                 // Iterate over symbols             |
         display_symbol(i);                          //                                  |
-        __delay_cycles(2000000);                    //                                  |
+        lcd_delay_ms(250);                          //                                  |
         clear_symbol(i);                            //                                  |
     }                                               //                                  |
                                                     ////////////////////////////////////|
     for (j = 0; j <= 100; j ++){                    // Iterate over numbers             |
         display_num(j);                             //                                  |
-        __delay_cycles(2000000);                    //                                  |
+        lcd_delay_ms(250);                          //                                  |
         clear_lcd();                                //                                  |
     }                                               //                                  |
                                                     ////////////////////////////////////|
@@ -72,9 +85,14 @@ void set_board(void)
 {
     //------------------------------------------------------------------------------------------|
     ////////////////////////////////////////////////////////////////////////////////////////////|
-    ctxGpio_t setup = { 0 };                            // Instantiate struct                   |
+    if (lpm5_restore())                                 // Woke from LPMx.5: pins, clocks       |
+    {                                                   // and display come back from FRAM      |
+        if (!lcd_lpm5_restore())                        //                                      |
+            init_lcd();                                 //                                      |
+        return;                                         //                                      |
+    }                                                   //                                      |
                                                         ////////////////////////////////////////|
-    gpio_init(&setup);                                  // Setup pins                           |
+    gpio_config(board, 0);                              // Setup pins                           |
                                                         ////////////////////////////////////////|
     clk_init(DCO_8MHZ);                                 // Initialize clock with 8MHz DCO       |
                                                         ////////////////////////////////////////|
@@ -0,0 +1,817 @@
+/****************************************************************
+ * Author: John J. Patti
+ *
+ * Version: 0.1
+ * Description: Host Benchmark for the LCD Library
+ * File: bench.cpp
+ *
+ * Copyright (c) 2020, John J. Patti
+ * All rights reserved.
+ *
+ * Documents:
+ *  Technical Reference Manual for the MSP430FR6989
+ *  (Document No. SLAU367O) ("TRM")
+ *
+ *  Datasheet for the MSP430FR6989 ("Datasheet")
+ *
+ *  MSP430FR6989 LaunchPad DevelopmentKit(MSP--EXP430FR6989)
+ *  User's Guide (Document No. SLAU627A) ("User's Guide")
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the Software), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ ***************************************************************/
+
+#include "sim.h"
+#include "liblcd.h"
+#include "libsetup.h"
+#include <stdio.h>
+#include <string.h>
+
+/****************************************************************
+ * Typedefs and Structs
+ ***************************************************************/
+typedef struct{
+    const char *name;           // Printed label
+    void (*run)(void);          // Measured call
+    int render;                 // Print the frame afterwards
+    void (*check)(void);        // Expected state afterwards, or 0
+} bench_t;
+
+/****************************************************************
+ * Interrupt service routines driven from the idle hook
+ ***************************************************************/
+void scroll_isr(void);
+void delay_isr(void);
+#if LCD_USE_CLOCK
+void clock_isr(void);
+#endif
+#if LCD_USE_TIMER
+void timer_isr(void);
+#endif
+#if LCD_USE_DMA
+void dma_isr(void);
+#endif
+
+/***************************************************************
+ * @brief   Idle hook; every low-power entry is ended by the next
+ *          pending timer interrupt
+ * @param   "sr" - status register bits being set
+ * @return  None
+ **************************************************************/
+static void bench_idle(uint16_t sr)
+{
+    (void) sr;
+    if (sim_peek(SIM_TA0 + 0x02, 2) & CCIE)        // TA0CCTL0, not counted
+        delay_isr();
+    else if (sim_peek(SIM_TA1 + 0x02, 2) & CCIE)   // TA1CCTL0
+        scroll_isr();
+}
+
+/****************************************************************
+ * Checks
+ ***************************************************************/
+static const char *bench_case;          // Case being checked
+static unsigned int bench_checks;       // Expectations evaluated
+static unsigned int bench_failed;       // Expectations not met
+
+/***************************************************************
+ * @brief   Records one expectation of the current case
+ * @param   "ok"   - non-zero if met
+ *          "what" - printed on stderr if not
+ * @return  None
+ **************************************************************/
+static void bench_expect(int ok, const char *what)
+{
+    bench_checks++;
+    if (!ok)
+    {
+        bench_failed++;
+        fprintf(stderr, "FAIL %s: %s\n", bench_case, what);
+    }
+}
+
+#define EXPECT(x)       bench_expect((x) != 0, #x)
+
+/***************************************************************
+ * @brief   Checks the characters on display
+ * @param   "text" - six characters, LCD_A1 first
+ * @return  None
+ *
+ * Each position must show the font glyph of its character;
+ * the indicator bits of the low byte are not compared.
+ **************************************************************/
+static void expect_text(const char *text)
+{
+    static const uint8_t pos[6] = { LCD_A1, LCD_A2, LCD_A3,
+                                    LCD_A4, LCD_A5, LCD_A6 };
+    const uint8_t *mem = sim_visible();
+    char what[64];
+    uint16_t got = 0, want;
+    int i, ok = 1;
+
+    for (i = 0; i < 6 && ok; i++)
+    {
+        got = ((mem[pos[i]] << 8) | mem[pos[i] + 1]) & ~0x0005;
+        want = lcd_font[text[i] - LCD_FONT_FIRST] & ~0x0005;
+        ok = (got == want);
+    }
+    snprintf(what, sizeof(what), "text \"%s\", A%d is 0x%04X", text, i, got);
+    bench_expect(ok, what);
+}
+
+/***************************************************************
+ * @brief   Checks the indicators and symbols on display
+ * @param   "names" - expected list in sim_indicators() order,
+ *                    e.g. "COL1 DP4 TMR", or "" for none
+ * @return  None
+ **************************************************************/
+static void expect_ind(const char *names)
+{
+    char got[128], what[320];
+
+    sim_indicators(sim_visible(), got, sizeof(got));
+    snprintf(what, sizeof(what), "indicators \"%s\", got \"%s\"", names, got);
+    bench_expect(strcmp(got, names) == 0, what);
+}
+
+/****************************************************************
+ * Benchmark cases
+ ***************************************************************/
+static void b_gpio_init(void)
+{
+    ctxGpio_t setup;
+    memset(&setup, 0, sizeof(setup));
+    gpio_init(&setup);
+}
+static const ctxPort_t board[GPIO_PORTS] = {
+    { 0xFFFF, 0, 0, 0, 0, 0, 0 }, { 0xFFFF, 0, 0, 0, 0, 0, 0 },
+    { 0xFFFF, 0, 0, 0, 0, 0, 0 }, { 0xFFFF, 0, 0, 0, 0, 0, 0 },
+    { 0, 0, 0, BIT4 | BIT5, 0, 0, 0 } };
+static void b_gpio_config(void)     { gpio_config(board, 0); }
+static void b_clk_init(void)        { clk_init(DCO_8MHZ); }
+static void b_clk_16(void)          { clk_init(DCO_16MHZ); }
+static void b_clk_noxt(void)
+{
+    sim_lfxt_fault = 1;
+    clk_init(DCO_8MHZ);
+    sim_lfxt_fault = 0;
+}
+static void b_init_lcd(void)        { init_lcd(); }
+static void b_char(void)            { display_char('A', LCD_A1); }
+static void b_msg(void)             { display_msg("HELLO"); }
+static void b_msg_same(void)        { display_msg("HELLO"); }
+static void b_msg_lower(void)       { display_msg("a-b/c*"); }
+static void b_msg_time(void)        { display_msg("12:34:56"); }
+static void b_msg_neg(void)         { display_msg("-12.345"); }
+static void b_msg_pi(void)          { display_msg("3.14159"); }
+static const lcd_frame_t ready = LCD_FRAME("READY ");
+static const lcd_frame_t cal = {
+    { LCD_GLYPH('C'), LCD_GLYPH('A'), LCD_GLYPH('L') | FRAME_DP,
+      LCD_GLYPH('2'), LCD_GLYPH('5'), LCD_GLYPH('C') } };
+static void b_frame(void)           { lcd_show_frame(&ready); }
+static void b_frame_same(void)      { lcd_show_frame(&ready); }
+static void b_frame_cal(void)       { lcd_show_frame(&cal); }
+static void b_printf_temp(void)     { lcd_printf("T%3d" LCD_ESC_DEG "C", 21); }
+static void b_printf_temp2(void)    { lcd_printf("T%3d" LCD_ESC_DEG "C", 22); }
+static void b_printf_fixed(void)    { lcd_printf("%6.2ld", -2347L); }
+static void b_printf_star(void)     { lcd_printf("%*.*d", 6, 1, 425); }
+static void b_printf_bad(void)      { lcd_printf("%d%+d%d", 7, 8, 9); }
+static void b_num(void)             { display_num(12345); }
+static void b_num_inc(void)         { display_num(12346); }
+static void b_num32_neg(void)       { display_num32(-654321L, NUM_RIGHT); }
+static void b_num32_pad(void)       { display_num32(42, NUM_ZEROPAD); }
+static void b_unum32_ovf(void)      { display_unum32(4000000000UL, NUM_RIGHT); }
+static void b_fixed(void)           { display_fixed(2347, 2); }
+static void b_auto(void)            { display_auto(1200, 0); }
+static void b_auto_big(void)        { display_auto(2000000000L, 127); }
+static void b_sym_batt(void)        { display_symbol(BATT_SYM); }
+static void b_sym_dp2(void)         { display_symbol(DP2_SYM); }
+static void b_clr_sym(void)         { clear_symbol(BATT_SYM); }
+static void b_sym_gauge(void)       { lcd_symbols_set(SYM_MASK_BATT, 0); }
+static void b_sym_gauge_off(void)   { lcd_symbols_set(0, SYM_MASK_BATT); }
+static void b_sym_keep(void)        { display_msg("HELLO"); }
+static void b_blink_pos(void)       { lcd_blink_position(LCD_A2, 1); }
+static void b_blink_sym(void)       { lcd_blink_symbol(EXCL_SYM, 1); }
+static void b_blink_off(void)       { lcd_blink_position(LCD_A2, 0); lcd_blink_symbol(EXCL_SYM, 0); }
+static void b_batt_50(void)         { lcd_battery_level(50); }
+static void b_batt_38(void)         { lcd_battery_level(38); }
+static void b_batt_1(void)          { lcd_battery_level(1); }
+static void b_batt_100(void)        { lcd_battery_level(100); }
+static void b_batt_dbuf(void)       { lcd_set_double_buffer(1); }
+static void b_clear(void)           { clear_lcd(); }
+static void b_scroll(void)          { scroll_text("HI"); }
+static void b_scroll_start(void)    { scroll_start("HI", SCROLL_STEP_MS); }
+static void b_scroll_step(void)     { scroll_isr(); }
+static void b_scroll_stop(void)     { scroll_stop(); }
+
+static int bench_getc(void *arg)
+{
+    unsigned int *n = (unsigned int*) arg;
+    return (*n)++ < 40 ? 'A' + (*n % 26) : SCROLL_EOF;
+}
+static void b_scroll_stream(void)
+{
+    unsigned int n = 0;
+    scroll_start_stream(bench_getc, &n, SCROLL_STEP_MS);
+    while (scroll_busy())
+        __bis_SR_register(LPM3_bits | GIE);
+}
+static void b_dbuf_on(void)         { lcd_set_double_buffer(1); }
+static void b_dbuf_num(void)        { display_num(4321); }
+static void b_dbuf_num_inc(void)    { display_num(4322); }
+static void b_dbuf_off(void)        { lcd_set_double_buffer(0); }
+static void b_prof_low(void)        { lcd_set_power_profile(&lcd_profile_low_power); }
+static void b_prof_def(void)        { lcd_set_power_profile(&lcd_profile_default); }
+static void b_delay(void)
+{
+    __disable_interrupt();
+    lcd_delay_ms(250);
+}
+static void b_delay_long(void)
+{
+    __enable_interrupt();
+    lcd_delay_ms(60000);
+}
+static void b_prof_idle(void)       { clk_set_profile(&clk_profile_idle); }
+static void b_prof_run(void)        { clk_set_profile(&clk_profile_run); }
+static const ctxClkCfg_t bench_aclk_half = {            // clk_profile_run, ACLK / 2
+    DCO_16MHZ, CLK_DCO, CLK_DIV_1, CLK_DCO, CLK_DIV_1,
+    CLK_LFXT, CLK_DIV_2, LFXT_TIMEOUT_MS
+};
+static void b_aclk_half(void)       { clk_set_profile(&bench_aclk_half); }
+#if LCD_USE_CLOCK
+static void bench_rtc_tick(uint8_t h, uint8_t m, uint8_t sec)
+{
+    sim_mem[0x04B2] = h;                                // RTC_C advanced, not counted
+    sim_mem[0x04B1] = m;
+    sim_mem[0x04B0] = sec;
+    sim_mem[0x04AE] = RTCIV__RTCRDYIFG;
+    clock_isr();
+}
+static void b_clock_start(void)
+{
+    sim_mem[0x04A0] |= RTCAIE;                          // Application alarm
+    sim_mem[0x04A2] |= RTCTEV_3;                        // and interval
+    clear_lcd();
+    lcd_clock_set(12, 34, 56);
+    lcd_clock_start(CLOCK_24H | CLOCK_BLINK);
+}
+static void b_clock_sec(void)       { bench_rtc_tick(0x12, 0x34, 0x57); }
+static void b_clock_hour(void)      { bench_rtc_tick(0x13, 0x00, 0x00); }
+static uint16_t bench_rtc_iv;                           // Last forwarded RTCIV
+static void bench_rtc_other(uint16_t iv) { bench_rtc_iv = iv; }
+static void b_clock_alarm(void)
+{
+    lcd_clock_set_callback(bench_rtc_other);
+    sim_mem[0x04AE] = RTCIV__RTCAIFG;                   // Alarm pending
+    clock_isr();
+}
+static void b_clock_12h(void)       { lcd_clock_start(CLOCK_12H); }
+static void b_clock_stop(void)      { lcd_clock_stop(); }
+#endif
+#if LCD_USE_TIMER
+static void b_timer_start(void)
+{
+    lcd_timer_set(0, 0, 0);
+    lcd_timer_start(TIMER_UP);
+}
+static void b_timer_step(void)      { timer_isr(); }
+static void b_timer_carry(void)
+{
+    lcd_timer_set(9, 59, 99);
+    sim_reset_stats();                                  // Measure the ISR only
+    timer_isr();
+}
+static uint32_t bench_lap;                              // Last lcd_timer_lap()
+static void b_timer_lap(void)
+{
+    __enable_interrupt();
+    bench_lap = lcd_timer_lap(1);
+    timer_isr();                                        // Held: not drawn
+}
+static void b_timer_down(void)
+{
+    lcd_timer_set(0, 0, 1);
+    lcd_timer_start(TIMER_DOWN);
+    timer_isr();
+}
+#endif
+static void b_warm_boot(void)       { init_lcd(); }
+static void b_lpm5_save(void)
+{
+    display_num(1234);
+    lcd_lpm5_save();
+    lpm5_save(board);
+    lpm5_enter(LPM5_LPM3);
+}
+static void b_lpm5_wake(void)
+{
+    sim_mem[0x019E] = SYSRSTIV_LPM5WU;                  // Reset cause, not counted
+    lpm5_restore();
+    lcd_lpm5_restore();
+}
+static void b_lpm5_wake_off(void)
+{
+    sim_mem[0x019E] = SYSRSTIV_LPM5WU;
+    sim_mem[0x0A00] &= ~LCDON;                          // LCD_C stopped (LPM4.5)
+    memset(&sim_mem[SIM_LCDM1], 0, SIM_LCDM_SIZE);
+    lpm5_restore();
+    lcd_lpm5_restore();
+}
+static void b_cpu_frame(void)       { display_msg("FRAME0"); }
+#if LCD_USE_DMA
+static void b_dma_on(void)          { lcd_set_dma(1, 0); }
+static void bench_dma_isrs(void)
+{
+    while (lcd_dma_busy())                              // Block done at once,
+        dma_isr();                                      // one ISR per block
+}
+static void b_dma_frame(void)       { display_msg("FRAME1"); bench_dma_isrs(); }
+static void b_dma_same(void)        { display_msg("FRAME1"); }
+static void b_dma_dbuf(void)
+{
+    lcd_set_double_buffer(1);
+    display_msg("FRAME2");
+    bench_dma_isrs();
+}
+static uint16_t bench_dma_iv;                           // Last forwarded DMAIV
+static void bench_dma_other(uint16_t iv) { bench_dma_iv = iv; }
+static void b_dma_other(void)
+{
+    lcd_dma_set_callback(bench_dma_other);
+    sim_mem[0x050E] = DMAIV__DMA1IFG;                   // Application channel
+    dma_isr();
+}
+static void b_dma_off(void)
+{
+    lcd_set_double_buffer(0);
+    lcd_set_dma(0, 0);
+    display_msg("FRAME3");
+}
+#endif
+
+
+/****************************************************************
+ * Expected results
+ ***************************************************************/
+static void c_unchanged(void)       { EXPECT(sim_stats.lcd_writes == 0); }
+static void c_gpio_config(void)
+{
+    EXPECT(PADIR == 0xFFFF);
+    EXPECT(PJSEL0 == (BIT4 | BIT5));
+    EXPECT(!(PM5CTL0 & LOCKLPM5));
+}
+static void c_clk_16(void)
+{
+    EXPECT(clk_get()->mclk == 16000000UL);
+    EXPECT((FRCTL0 & NWAITS_7) == NWAITS_1);
+}
+static void c_clk_noxt(void)        { EXPECT(clk_get()->aclk == VLO_HZ); }
+static void c_clk_init(void)
+{
+    EXPECT(clk_get()->mclk == 8000000UL);
+    EXPECT(clk_get()->aclk == LFXT_HZ);
+}
+static void c_init_lcd(void)
+{
+    EXPECT(LCDCCTL0 & LCDON);
+    expect_text("      ");
+    expect_ind("");
+}
+static void c_char(void)            { expect_text("A     "); }
+static void c_msg(void)
+{
+    expect_text("HELLO ");
+    EXPECT(sim_stats.lcd_writes == 5);
+}
+static void c_msg_lower(void)       { expect_text("a-b/c*"); }
+static void c_msg_time(void)
+{
+    expect_text("123456");
+    expect_ind("COL1 COL2");
+}
+static void c_msg_neg(void)
+{
+    expect_text("12345 ");
+    expect_ind("NEG DP2");
+}
+static void c_msg_pi(void)
+{
+    expect_text("314159");
+    expect_ind("DP1");
+}
+static void c_frame(void)
+{
+    expect_text("READY ");
+    expect_ind("");
+}
+static void c_frame_cal(void)
+{
+    expect_text("CAL25C");
+    expect_ind("DP3");
+}
+static void c_printf_temp(void)
+{
+    expect_text("T 21C ");
+    expect_ind("DEG");
+}
+static void c_printf_temp2(void)
+{
+    expect_text("T 22C ");
+    EXPECT(sim_stats.lcd_writes <= 2);
+}
+static void c_printf_fixed(void)
+{
+    expect_text("  2347");
+    expect_ind("NEG DP4");                              // DEG cleared
+}
+static void c_printf_star(void)
+{
+    expect_text("   425");
+    expect_ind("DP5");
+}
+static void c_printf_bad(void)
+{
+    EXPECT(sim_peek(SIM_LCDM1 + LCD_A2, 1) == 0xFF);    // Error trap
+    EXPECT(sim_peek(SIM_LCDM1 + LCD_A3, 1) == 0x00);    // Nothing after it
+    EXPECT(sim_peek(SIM_LCDM1 + LCD_A1, 1) == (lcd_font['7' - LCD_FONT_FIRST] >> 8));
+}
+static void c_num(void)             { expect_text(" 12345"); }
+static void c_num_inc(void)
+{
+    expect_text(" 12346");
+    EXPECT(sim_stats.lcd_writes == 1);
+}
+static void c_num32_neg(void)
+{
+    expect_text("654321");
+    expect_ind("NEG");
+}
+static void c_num32_pad(void)
+{
+    expect_text("000042");
+    expect_ind("");
+}
+static void c_unum32_ovf(void)      { expect_text("------"); }
+static void c_fixed(void)
+{
+    expect_text("  2347");
+    expect_ind("DP4");
+}
+static void c_auto(void)
+{
+    expect_text("   12k");
+    expect_ind("DP4");
+}
+static void c_auto_big(void)
+{
+    expect_text("99999T");
+    expect_ind("DP3");
+}
+static void c_sym_dp2(void)         { expect_ind("DP2 DP3 BATT"); }
+static void c_sym_gauge(void)
+{
+    expect_ind("DP2 DP3 [] B1 B3 B5 BATT B2 B4 B6");
+    EXPECT(sim_stats.lcd_writes == 2);
+}
+static void c_sym_keep(void)
+{
+    expect_text("HELLO ");
+    expect_ind("DP2");                                  // DP3 was the number's
+}
+static void c_blink_pos(void)
+{
+    EXPECT((LCDCBLKCTL & 0x0003) == LCDBLKMOD_1);
+    EXPECT(sim_peek(SIM_LCDBM1 + LCD_A2, 1) == 0xFF);
+}
+static void c_blink_off(void)       { EXPECT((LCDCBLKCTL & 0x0003) == LCDBLKMOD_0); }
+static void c_batt_50(void)         { expect_ind("DP2 [] B1 B3 BATT B2"); }
+static void c_batt_38(void)
+{
+    expect_ind("DP2 [] B1 B3 BATT B2");                 // Hysteresis keeps B3
+    EXPECT(sim_stats.lcd_writes == 0);
+}
+static void c_batt_1(void)
+{
+    expect_ind("DP2 [] BATT");
+    EXPECT(sim_peek(SIM_LCDBM1 + LCD_AT2, 1) & 0x10);  // [] blinks
+}
+static void c_batt_100(void)
+{
+    expect_ind("DP2 [] B1 B3 B5 BATT B2 B4 B6");
+    EXPECT((LCDCBLKCTL & 0x0003) == LCDBLKMOD_0);
+    EXPECT(LCDCMEMCTL & LCDDISP);                       // Double buffering resumed
+}
+static void c_clear(void)
+{
+    expect_text("      ");
+    expect_ind("");
+}
+static void c_scroll(void)
+{
+    expect_text("      ");
+    EXPECT(!scroll_busy());
+}
+static void c_scroll_start(void)
+{
+    EXPECT(scroll_busy());
+    EXPECT(TA1CCTL0 & CCIE);
+}
+static void c_scroll_step(void)     { expect_text("    HI"); }
+static void c_scroll_stop(void)
+{
+    EXPECT(!scroll_busy());
+    EXPECT(!(TA1CCTL0 & CCIE));
+}
+static void c_scroll_stream(void)
+{
+    EXPECT(!scroll_busy());
+    expect_text("      ");
+}
+static void c_dbuf_num(void)
+{
+    expect_text("  4321");
+    EXPECT(LCDCMEMCTL & LCDDISP);                       // LCDBMEM shown
+}
+static void c_dbuf_num_inc(void)
+{
+    expect_text("  4322");
+    EXPECT(!(LCDCMEMCTL & LCDDISP));                    // Back to LCDMEM
+}
+static void c_dbuf_off(void)
+{
+    expect_text("  4322");
+    EXPECT(!(LCDCMEMCTL & LCDDISP));
+}
+static void c_prof_low(void)
+{
+    EXPECT(!(LCDCVCTL & LCDCPEN));
+    EXPECT(LCDCCTL0 & LCDON);                           // Back on after reprogram
+}
+static void c_prof_def(void)
+{
+    EXPECT(LCDCVCTL & LCDCPEN);
+    expect_text("  4322");                              // Frame survives
+}
+static void c_delay(void)
+{
+    EXPECT(sim_stats.sleeps == 1);
+    EXPECT(TA0CCR0 == 250 * (LFXT_HZ / 8) / 1000 - 1);
+    EXPECT(!(__get_SR_register() & GIE));               // Left disabled
+}
+static void c_delay_long(void)
+{
+    EXPECT(sim_stats.sleeps == 4);
+    EXPECT(__get_SR_register() & GIE);                  // Left enabled
+}
+static void c_prof_idle(void)       { EXPECT(clk_get()->mclk == 1000000UL); }
+static void c_prof_run(void)
+{
+    EXPECT(clk_get()->mclk == 16000000UL);
+    EXPECT((LCDCCTL0 & 0xFF00) == (LCDDIV__1 | LCDPRE__16));    // Profile as written
+    EXPECT((LCDCBLKCTL & 0x00FC) == BLINK_1HZ);
+}
+static void c_aclk_half(void)
+{
+    EXPECT((LCDCCTL0 & 0xFF00) == (LCDDIV__8 | LCDPRE__1));     // Still 256 Hz
+    EXPECT((LCDCBLKCTL & 0x00FC) == (LCDBLKPRE_2 | LCDBLKDIV_7)); // Still 1 Hz
+    EXPECT(LCDCCTL0 & LCDON);
+    expect_text("  4322");
+}
+#if LCD_USE_CLOCK
+static void c_clock_start(void)
+{
+    expect_text("123456");
+    expect_ind("COL1 COL2");
+    EXPECT((sim_peek(0x04A0, 1) & (RTCAIE | RTCRDYIE)) == (RTCAIE | RTCRDYIE));
+    EXPECT((sim_peek(0x04A2, 1) & (RTCTEV_3 | RTCHOLD | RTCBCD)) == (RTCTEV_3 | RTCBCD));
+}
+static void c_clock_sec(void)
+{
+    expect_text("123457");
+    EXPECT(sim_stats.lcd_writes == 1);
+}
+static void c_clock_hour(void)      { expect_text("130000"); }
+static void c_clock_alarm(void)     { EXPECT(bench_rtc_iv == RTCIV__RTCAIFG); }
+static void c_clock_12h(void)       { expect_text(" 10000"); }
+static void c_clock_stop(void)
+{
+    EXPECT((sim_peek(0x04A0, 1) & (RTCAIE | RTCRDYIE)) == RTCAIE);
+}
+#endif
+#if LCD_USE_TIMER
+static void c_timer_start(void)
+{
+    expect_text("000000");
+    expect_ind("COL1 DP4 TMR");
+}
+static void c_timer_step(void)      { expect_text("000001"); }
+static void c_timer_carry(void)
+{
+    expect_text("100000");
+    expect_ind("COL1 DP4 TMR");
+}
+static void c_timer_lap(void)
+{
+    EXPECT(bench_lap == 0x00100000UL);
+    EXPECT(lcd_timer_get() == 0x00100001UL);
+    expect_text("100000");
+    EXPECT(__get_SR_register() & GIE);                  // Left enabled
+    lcd_timer_lap(0);
+    __disable_interrupt();
+}
+static void c_timer_down(void)      { expect_text("000000"); }
+#endif
+static void c_warm_boot(void)
+{
+#if LCD_USE_TIMER
+    expect_text("000000");                              // Last countdown frame
+    expect_ind("COL1 DP4 TMR");
+#else
+    expect_text("  4322");                              // Last double buffered frame
+    expect_ind("");
+#endif
+}
+static void c_lpm5_wake(void)
+{
+    expect_text("  1234");
+    EXPECT(sim_stats.lcd_writes == 0);                  // Glass kept its frame
+}
+static void c_lpm5_wake_off(void)   { expect_text("  1234"); }
+#if LCD_USE_DMA
+static void c_dma_frame(void)
+{
+    expect_text("FRAME1");
+    EXPECT(sim_stats.lcd_writes == 0);
+    EXPECT(sim_stats.dma == 2);                         // Only A6 changed
+    EXPECT(!lcd_dma_busy());
+}
+static void c_dma_same(void)        { EXPECT(sim_stats.dma == 0); }
+static void c_dma_dbuf(void)
+{
+    expect_text("FRAME2");
+    EXPECT(!lcd_dma_busy());
+}
+static void c_dma_other(void)
+{
+    EXPECT(bench_dma_iv == DMAIV__DMA1IFG);
+    expect_text("FRAME2");
+}
+static void c_dma_off(void)
+{
+    expect_text("FRAME3");
+    EXPECT(sim_stats.lcd_writes == LCD_MEM_SIZE);       // DMA bank rewritten
+}
+#endif
+
+static const bench_t cases[] = {
+    { "gpio_init()",                     b_gpio_init,      0,  0 },
+    { "gpio_config(board)",              b_gpio_config,    0,  c_gpio_config },
+    { "clk_init(DCO_16MHZ)",             b_clk_16,         0,  c_clk_16 },
+    { "clk_init(DCO_8MHZ) no LFXT",      b_clk_noxt,       0,  c_clk_noxt },
+    { "clk_init(DCO_8MHZ)",              b_clk_init,       0,  c_clk_init },
+    { "init_lcd()",                      b_init_lcd,       0,  c_init_lcd },
+    { "display_char('A', LCD_A1)",       b_char,           1,  c_char },
+    { "display_msg(\"HELLO\")",          b_msg,            1,  c_msg },
+    { "display_msg(\"HELLO\") again",    b_msg_same,       0,  c_unchanged },
+    { "display_msg(\"a-b/c*\")",         b_msg_lower,      1,  c_msg_lower },
+    { "display_msg(\"12:34:56\")",       b_msg_time,       1,  c_msg_time },
+    { "display_msg(\"-12.345\")",        b_msg_neg,        1,  c_msg_neg },
+    { "display_msg(\"3.14159\")",        b_msg_pi,         1,  c_msg_pi },
+    { "lcd_show_frame(READY)",           b_frame,          1,  c_frame },
+    { "lcd_show_frame(READY) again",     b_frame_same,     0,  c_unchanged },
+    { "lcd_show_frame(CAL.25C)",         b_frame_cal,      1,  c_frame_cal },
+    { "lcd_printf(\"T%3d\"DEG\"C\")",    b_printf_temp,    1,  c_printf_temp },
+    { "lcd_printf(...) next value",      b_printf_temp2,   0,  c_printf_temp2 },
+    { "lcd_printf(\"%6.2ld\")",          b_printf_fixed,   1,  c_printf_fixed },
+    { "lcd_printf(\"%*.*d\")",           b_printf_star,    0,  c_printf_star },
+    { "lcd_printf(\"%d%+d%d\")",         b_printf_bad,     1,  c_printf_bad },
+    { "display_num(12345)",              b_num,            1,  c_num },
+    { "display_num(12346)",              b_num_inc,        0,  c_num_inc },
+    { "display_num32(-654321)",          b_num32_neg,      1,  c_num32_neg },
+    { "display_num32(42, ZEROPAD)",      b_num32_pad,      0,  c_num32_pad },
+    { "display_unum32(4000000000)",      b_unum32_ovf,     1,  c_unum32_ovf },
+    { "display_fixed(2347, 2)",          b_fixed,          1,  c_fixed },
+    { "display_auto(1200, 0)",           b_auto,           1,  c_auto },
+    { "display_auto(2e9, 127)",          b_auto_big,       1,  c_auto_big },
+    { "display_symbol(BATT_SYM)",        b_sym_batt,       0,  0 },
+    { "display_symbol(DP2_SYM)",         b_sym_dp2,        1,  c_sym_dp2 },
+    { "clear_symbol(BATT_SYM)",          b_clr_sym,        0,  0 },
+    { "lcd_symbols_set(BATT, 0)",        b_sym_gauge,      1,  c_sym_gauge },
+    { "lcd_symbols_set(0, BATT)",        b_sym_gauge_off,  0,  0 },
+    { "display_msg(\"HELLO\") + DP2",    b_sym_keep,       1,  c_sym_keep },
+    { "lcd_blink_position(LCD_A2, 1)",   b_blink_pos,      1,  c_blink_pos },
+    { "lcd_blink_symbol(EXCL_SYM, 1)",   b_blink_sym,      0,  0 },
+    { "lcd_blink_*(..., 0)",             b_blink_off,      0,  c_blink_off },
+    { "lcd_battery_level(50)",           b_batt_50,        1,  c_batt_50 },
+    { "lcd_battery_level(50) again",     b_batt_50,        0,  c_unchanged },
+    { "lcd_battery_level(38) hyst",      b_batt_38,        0,  c_batt_38 },
+    { "lcd_set_double_buffer(1)",        b_batt_dbuf,      0,  0 },
+    { "lcd_battery_level(1) [dbuf]",     b_batt_1,         1,  c_batt_1 },
+    { "lcd_battery_level(100) [dbuf]",   b_batt_100,       1,  c_batt_100 },
+    { "lcd_set_double_buffer(0)",        b_dbuf_off,       0,  0 },
+    { "clear_lcd()",                     b_clear,          0,  c_clear },
+    { "scroll_text(\"HI\")",             b_scroll,         0,  c_scroll },
+    { "scroll_start(\"HI\", 250)",       b_scroll_start,   0,  c_scroll_start },
+    { "scroll step (TIMER1_A0 ISR)",     b_scroll_step,    0,  0 },
+    { "scroll step (TIMER1_A0 ISR)",     b_scroll_step,    1,  c_scroll_step },
+    { "scroll_stop()",                   b_scroll_stop,    0,  c_scroll_stop },
+    { "scroll_start_stream(40 chars)",   b_scroll_stream,  0,  c_scroll_stream },
+    { "lcd_set_double_buffer(1)",        b_dbuf_on,        0,  0 },
+    { "display_num(4321) [dbuf]",        b_dbuf_num,       1,  c_dbuf_num },
+    { "display_num(4322) [dbuf]",        b_dbuf_num_inc,   1,  c_dbuf_num_inc },
+    { "lcd_set_double_buffer(0)",        b_dbuf_off,       1,  c_dbuf_off },
+    { "lcd_set_power_profile(low)",      b_prof_low,       0,  c_prof_low },
+    { "lcd_set_power_profile(default)",  b_prof_def,       0,  c_prof_def },
+    { "lcd_delay_ms(250)",               b_delay,          0,  c_delay },
+    { "lcd_delay_ms(60000)",             b_delay_long,     0,  c_delay_long },
+    { "clk_set_profile(idle)",           b_prof_idle,      0,  c_prof_idle },
+    { "clk_set_profile(run)",            b_prof_run,       0,  c_prof_run },
+    { "clk_set_profile(ACLK / 2)",       b_aclk_half,      0,  c_aclk_half },
+    { "clk_set_profile(run) again",      b_prof_run,       0,  c_prof_run },
+#if LCD_USE_CLOCK
+    { "lcd_clock_start(24H | BLINK)",    b_clock_start,    1,  c_clock_start },
+    { "clock second (RTC ISR)",          b_clock_sec,      1,  c_clock_sec },
+    { "clock hour (RTC ISR)",            b_clock_hour,     0,  c_clock_hour },
+    { "RTC alarm -> callback",           b_clock_alarm,    0,  c_clock_alarm },
+    { "lcd_clock_start(12H)",            b_clock_12h,      1,  c_clock_12h },
+    { "lcd_clock_stop()",                b_clock_stop,     0,  c_clock_stop },
+#endif
+#if LCD_USE_TIMER
+    { "lcd_timer_start(TIMER_UP)",       b_timer_start,    1,  c_timer_start },
+    { "timer step (TIMER2_A0 ISR)",      b_timer_step,     0,  c_timer_step },
+    { "timer 09:59.99 -> 10:00.00",      b_timer_carry,    1,  c_timer_carry },
+    { "lcd_timer_lap(1) with GIE set",   b_timer_lap,      0,  c_timer_lap },
+    { "countdown to 00:00.00",           b_timer_down,     1,  c_timer_down },
+#endif
+    { "init_lcd() warm boot",            b_warm_boot,      1,  c_warm_boot },
+    { "lcd_lpm5_save(), lpm5_enter()",   b_lpm5_save,      0,  0 },
+    { "LPM3.5 wake, lcd_lpm5_restore()", b_lpm5_wake,      1,  c_lpm5_wake },
+    { "LPM4.5 wake, lcd_lpm5_restore()", b_lpm5_wake_off,  1,  c_lpm5_wake_off },
+    { "display_msg(\"FRAME0\") [cpu]",   b_cpu_frame,      0,  0 },
+#if LCD_USE_DMA
+    { "lcd_set_dma(1)",                  b_dma_on,         0,  0 },
+    { "display_msg(\"FRAME1\") [dma]",   b_dma_frame,      1,  c_dma_frame },
+    { "display_msg(\"FRAME1\") again",   b_dma_same,       0,  c_dma_same },
+    { "display_msg(\"FRAME2\") [dbuf+dma]", b_dma_dbuf,       1,  c_dma_dbuf },
+    { "DMA1 -> callback",                b_dma_other,      0,  c_dma_other },
+    { "lcd_set_dma(0), \"FRAME3\"",      b_dma_off,        1,  c_dma_off },
+#endif
+};
+
+/***************************************************************
+ * @brief   Runs every benchmark case against the simulated
+ *          register file and prints per-call access counts
+ * @param   "-q" suppresses the rendered frames
+ * @return  0
+ **************************************************************/
+int main(int argc, char **argv)
+{
+    //----------------------------------------------------------------------------------|
+    unsigned int i;                                         // Loop variable            |
+    int frames = !(argc > 1 && strcmp(argv[1], "-q") == 0); // Render frames?           |
+                                                            ////////////////////////////|
+    sim_reset();                                            // Power-on register state  |
+    sim_set_idle_hook(bench_idle);                          // Timers fire on LPM entry |
+    printf("%-32s %7s %7s %7s %9s %11s %6s %6s\n", "call", //                          |
+           "reads", "writes", "lcdmem", "cycles", "delay",  //                          |
+           "lpm", "dma");                                   //                          |
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) //                          |
+    {                                                       //                          |
+        sim_reset_stats();                                  //                          |
+        bench_case = cases[i].name;                         // Named in FAIL lines      |
+        cases[i].run();                                     //                          |
+        printf("%-32s %7lu %7lu %7lu %9lu %11lu %6lu %6lu\n", //                       |
+               cases[i].name, sim_stats.reads,              //                          |
+               sim_stats.writes, sim_stats.lcd_writes,      //                          |
+               sim_stats.cycles - sim_stats.delay,          //                          |
+               sim_stats.delay, sim_stats.sleeps,           //                          |
+               sim_stats.dma);                              //                          |
+        if (frames && cases[i].render)                      //                          |
+            sim_render(stdout);                             //                          |
+        if (cases[i].check)                                 // Compare with expected    |
+            cases[i].check();                               //                          |
+    }                                                       //                          |
+    printf("%u checks, %u failed\n", bench_checks,          //                          |
+           bench_failed);                                   //                          |
+    return bench_failed != 0;                               // Non-zero fails make check|
+    //----------------------------------------------------------------------------------|
+}
@@ -0,0 +1,636 @@
+/****************************************************************
+ * Author: John J. Patti
+ *
+ * Version: 0.1
+ * Description: Simulated MSP430FR6989 Device Header
+ * File: msp430.h
+ *
+ * Copyright (c) 2020, John J. Patti
+ * All rights reserved.
+ *
+ * Documents:
+ *  Technical Reference Manual for the MSP430FR6989
+ *  (Document No. SLAU367O) ("TRM")
+ *
+ *  Datasheet for the MSP430FR6989 ("Datasheet")
+ *
+ *  MSP430FR6989 LaunchPad DevelopmentKit(MSP--EXP430FR6989)
+ *  User's Guide (Document No. SLAU627A) ("User's Guide")
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the Software), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ ***************************************************************/
+
+#ifndef SIM_MSP430_H_
+#define SIM_MSP430_H_
+
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Host stand-in for the TI <msp430.h> device header.      |
+//                                                         |
+// Every register macro expands to a small proxy object    |
+// that forwards each read, write and read-modify-write to |
+// the simulated register file in sim.cpp, where the access|
+// is counted.  The proxies rely on operator overloading,  |
+// so the library sources are compiled as C++ on the host  |
+// (see sim/Makefile).  Addresses and bit values follow    |
+// the MSP430FR6989 device header.                         |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#ifndef __cplusplus
+#error "sim/msp430.h must be compiled as C++ (g++ -x c++)"
+#endif
+
+/****************************************************************
+ * Header includes
+ ***************************************************************/
+#include <stdint.h>
+#include "sim.h"
+
+/****************************************************************
+ * Register proxies
+ ***************************************************************/
+template <typename T>
+struct sim_reg{
+    uint16_t addr;
+
+    operator T() const { return (T) sim_read(addr, sizeof(T)); }
+
+    sim_reg& operator=(unsigned int v)
+        { sim_write(addr, (T) v, sizeof(T)); return *this; }
+    sim_reg& operator=(const sim_reg &r)
+        { return *this = (unsigned int) (T) r; }
+    sim_reg& operator|=(unsigned int v)
+        { sim_modify(addr, (T) (sim_peek(addr, sizeof(T)) | v), sizeof(T)); return *this; }
+    sim_reg& operator&=(unsigned int v)
+        { sim_modify(addr, (T) (sim_peek(addr, sizeof(T)) & v), sizeof(T)); return *this; }
+    sim_reg& operator^=(unsigned int v)
+        { sim_modify(addr, (T) (sim_peek(addr, sizeof(T)) ^ v), sizeof(T)); return *this; }
+    sim_reg& operator+=(unsigned int v)
+        { sim_modify(addr, (T) (sim_peek(addr, sizeof(T)) + v), sizeof(T)); return *this; }
+    sim_reg& operator-=(unsigned int v)
+        { sim_modify(addr, (T) (sim_peek(addr, sizeof(T)) - v), sizeof(T)); return *this; }
+};
+
+template <typename T>
+struct sim_bank{
+    uint16_t base;
+
+    sim_reg<T> operator[](int i) const
+        { return sim_reg<T>{ (uint16_t) (base + i * sizeof(T)) }; }
+    sim_bank operator+(int i) const
+        { return sim_bank{ (uint16_t) (base + i * sizeof(T)) }; }
+};
+
+// DMA address registers (DMAxSA/DMAxDA).  The library sets them
+// with a pointer; RAM on the host lies outside sim_mem, so the
+// proxy hands the host address to sim.cpp.
+struct sim_addr{
+    uint16_t addr;
+
+    sim_addr& operator=(const volatile void *p)
+        { sim_set_addr(addr, p); return *this; }
+    sim_addr& operator=(const sim_bank<uint8_t> &b)
+        { sim_set_addr(addr, &sim_mem[b.base]); return *this; }
+};
+
+#define SIM_REG8(a)         (sim_reg<uint8_t>{ (uint16_t) (a) })
+#define SIM_REG16(a)        (sim_reg<uint16_t>{ (uint16_t) (a) })
+
+/****************************************************************
+ * Intrinsics
+ ***************************************************************/
+#define __delay_cycles(n)           sim_delay(n)
+#define __no_operation()            do { } while (0)
+#define __bis_SR_register(x)        sim_idle(x)
+#define __bic_SR_register(x)        do { sim_sr &= ~(x); } while (0)
+#define __bic_SR_register_on_exit(x) do { (void) (x); } while (0)
+#define __get_SR_register()         (sim_sr)
+#define __enable_interrupt()        do { sim_sr |= GIE; } while (0)
+#define __disable_interrupt()       do { sim_sr &= ~GIE; } while (0)
+#define __interrupt
+
+/****************************************************************
+ * Bit and status register defines
+ ***************************************************************/
+#define BIT0                (0x0001)
+#define BIT1                (0x0002)
+#define BIT2                (0x0004)
+#define BIT3                (0x0008)
+#define BIT4                (0x0010)
+#define BIT5                (0x0020)
+#define BIT6                (0x0040)
+#define BIT7                (0x0080)
+#define BIT8                (0x0100)
+#define BIT9                (0x0200)
+#define BITA                (0x0400)
+#define BITB                (0x0800)
+#define BITC                (0x1000)
+#define BITD                (0x2000)
+#define BITE                (0x4000)
+#define BITF                (0x8000)
+
+#define GIE                 (0x0008)
+#define CPUOFF              (0x0010)
+#define OSCOFF              (0x0020)
+#define SCG0                (0x0040)
+#define SCG1                (0x0080)
+#define LPM0_bits           (CPUOFF)
+#define LPM3_bits           (SCG1 | SCG0 | CPUOFF)
+#define LPM4_bits           (SCG1 | SCG0 | OSCOFF | CPUOFF)
+
+/****************************************************************
+ * SFR, PMM and watchdog
+ ***************************************************************/
+#define SFRIE1              SIM_REG16(0x0100)
+#define SFRIFG1             SIM_REG16(0x0102)
+#define SFRRPCR             SIM_REG16(0x0104)
+#define OFIFG               (0x0002)
+#define OFIE                (0x0002)
+
+#define PMMCTL0             SIM_REG16(0x0120)
+#define PMMCTL0_L           SIM_REG8(0x0120)
+#define PMMCTL0_H           SIM_REG8(0x0121)
+#define PMMPW               (0xA500)
+#define PMMPW_H             (0xA5)
+#define PMMREGOFF           (0x0010)
+#define SVSHE               (0x0040)
+
+#define PM5CTL0             SIM_REG16(0x0130)
+#define LOCKLPM5            (0x0001)
+
+#define SYSRSTIV            SIM_REG16(0x019E)
+#define SYSRSTIV_NONE       (0x0000)
+#define SYSRSTIV_BOR        (0x0002)
+#define SYSRSTIV_LPM5WU     (0x0008)
+
+#define WDTCTL              SIM_REG16(0x015C)
+#define WDTPW               (0x5A00)
+#define WDTHOLD             (0x0080)
+
+/****************************************************************
+ * FRAM controller
+ ***************************************************************/
+#define FRCTL0              SIM_REG16(0x0140)
+#define FRCTLPW             (0xA500)
+#define NWAITS_0            (0x0000)
+#define NWAITS_1            (0x0010)
+#define NWAITS_2            (0x0020)
+#define NWAITS_3            (0x0030)
+#define NWAITS_4            (0x0040)
+#define NWAITS_5            (0x0050)
+#define NWAITS_6            (0x0060)
+#define NWAITS_7            (0x0070)
+
+/****************************************************************
+ * Clock system (CS)
+ ***************************************************************/
+#define CSCTL0              SIM_REG16(0x0160)
+#define CSCTL0_H            SIM_REG8(0x0161)
+#define CSCTL1              SIM_REG16(0x0162)
+#define CSCTL2              SIM_REG16(0x0164)
+#define CSCTL3              SIM_REG16(0x0166)
+#define CSCTL4              SIM_REG16(0x0168)
+#define CSCTL5              SIM_REG16(0x016A)
+#define CSCTL6              SIM_REG16(0x016C)
+
+#define CSKEY               (0xA500)
+#define CSKEY_H             (0xA5)
+
+#define DCORSEL             (0x0040)
+#define DCOFSEL_0           (0x0000)
+#define DCOFSEL_1           (0x0002)
+#define DCOFSEL_2           (0x0004)
+#define DCOFSEL_3           (0x0006)
+#define DCOFSEL_4           (0x0008)
+#define DCOFSEL_5           (0x000A)
+#define DCOFSEL_6           (0x000C)
+
+#define SELM__LFXTCLK       (0x0000)
+#define SELM__VLOCLK        (0x0001)
+#define SELM__LFMODCLK      (0x0002)
+#define SELM__DCOCLK        (0x0003)
+#define SELM__MODCLK        (0x0004)
+#define SELM__HFXTCLK       (0x0005)
+#define SELS__LFXTCLK       (0x0000)
+#define SELS__VLOCLK        (0x0010)
+#define SELS__LFMODCLK      (0x0020)
+#define SELS__DCOCLK        (0x0030)
+#define SELS__MODCLK        (0x0040)
+#define SELS__HFXTCLK       (0x0050)
+#define SELA0               (0x0100)
+#define SELA1               (0x0200)
+#define SELA2               (0x0400)
+#define SELA__LFXTCLK       (0x0000)
+#define SELA__VLOCLK        (0x0100)
+#define SELA__LFMODCLK      (0x0200)
+
+#define DIVM__1             (0x0000)
+#define DIVM__2             (0x0001)
+#define DIVM__4             (0x0002)
+#define DIVM__8             (0x0003)
+#define DIVM__16            (0x0004)
+#define DIVM__32            (0x0005)
+#define DIVS__1             (0x0000)
+#define DIVS__2             (0x0010)
+#define DIVS__4             (0x0020)
+#define DIVS__8             (0x0030)
+#define DIVS__16            (0x0040)
+#define DIVS__32            (0x0050)
+#define DIVA0               (0x0100)
+#define DIVA1               (0x0200)
+#define DIVA2               (0x0400)
+#define DIVA__1             (0x0000)
+#define DIVA__2             (0x0100)
+#define DIVA__4             (0x0200)
+#define DIVA__8             (0x0300)
+#define DIVA__16            (0x0400)
+#define DIVA__32            (0x0500)
+
+#define LFXTOFF             (0x0001)
+#define SMCLKOFF            (0x0002)
+#define VLOOFF              (0x0008)
+#define LFXTBYPASS          (0x0010)
+#define HFXTOFF             (0x0100)
+
+#define LFXTOFFG            (0x0001)
+#define HFXTOFFG            (0x0002)
+
+/****************************************************************
+ * Digital I/O
+ ***************************************************************/
+#define SIM_PORT_ODD(b, o)  SIM_REG8((b) + (o))
+#define SIM_PORT_EVEN(b, o) SIM_REG8((b) + (o) + 1)
+
+#define P1IN                SIM_PORT_ODD(0x0200, 0x00)
+#define P1OUT               SIM_PORT_ODD(0x0200, 0x02)
+#define P1DIR               SIM_PORT_ODD(0x0200, 0x04)
+#define P1REN               SIM_PORT_ODD(0x0200, 0x06)
+#define P1SEL0              SIM_PORT_ODD(0x0200, 0x0A)
+#define P1SEL1              SIM_PORT_ODD(0x0200, 0x0C)
+#define P1IES               SIM_PORT_ODD(0x0200, 0x18)
+#define P1IE                SIM_PORT_ODD(0x0200, 0x1A)
+#define P1IFG               SIM_PORT_ODD(0x0200, 0x1C)
+#define P2IN                SIM_PORT_EVEN(0x0200, 0x00)
+#define P2OUT               SIM_PORT_EVEN(0x0200, 0x02)
+#define P2DIR               SIM_PORT_EVEN(0x0200, 0x04)
+#define P2REN               SIM_PORT_EVEN(0x0200, 0x06)
+#define P2SEL0              SIM_PORT_EVEN(0x0200, 0x0A)
+#define P2SEL1              SIM_PORT_EVEN(0x0200, 0x0C)
+#define P2IES               SIM_PORT_EVEN(0x0200, 0x18)
+#define P2IE                SIM_PORT_EVEN(0x0200, 0x1A)
+#define P2IFG               SIM_PORT_EVEN(0x0200, 0x1C)
+#define P3IN                SIM_PORT_ODD(0x0220, 0x00)
+#define P3OUT               SIM_PORT_ODD(0x0220, 0x02)
+#define P3DIR               SIM_PORT_ODD(0x0220, 0x04)
+#define P3REN               SIM_PORT_ODD(0x0220, 0x06)
+#define P3SEL0              SIM_PORT_ODD(0x0220, 0x0A)
+#define P3SEL1              SIM_PORT_ODD(0x0220, 0x0C)
+#define P3IES               SIM_PORT_ODD(0x0220, 0x18)
+#define P3IE                SIM_PORT_ODD(0x0220, 0x1A)
+#define P3IFG               SIM_PORT_ODD(0x0220, 0x1C)
+#define P4IN                SIM_PORT_EVEN(0x0220, 0x00)
+#define P4OUT               SIM_PORT_EVEN(0x0220, 0x02)
+#define P4DIR               SIM_PORT_EVEN(0x0220, 0x04)
+#define P4REN               SIM_PORT_EVEN(0x0220, 0x06)
+#define P4SEL0              SIM_PORT_EVEN(0x0220, 0x0A)
+#define P4SEL1              SIM_PORT_EVEN(0x0220, 0x0C)
+#define P4IES               SIM_PORT_EVEN(0x0220, 0x18)
+#define P4IE                SIM_PORT_EVEN(0x0220, 0x1A)
+#define P4IFG               SIM_PORT_EVEN(0x0220, 0x1C)
+#define P5OUT               SIM_PORT_ODD(0x0240, 0x02)
+#define P5DIR               SIM_PORT_ODD(0x0240, 0x04)
+#define P5REN               SIM_PORT_ODD(0x0240, 0x06)
+#define P5SEL0              SIM_PORT_ODD(0x0240, 0x0A)
+#define P5SEL1              SIM_PORT_ODD(0x0240, 0x0C)
+#define P6OUT               SIM_PORT_EVEN(0x0240, 0x02)
+#define P6DIR               SIM_PORT_EVEN(0x0240, 0x04)
+#define P6REN               SIM_PORT_EVEN(0x0240, 0x06)
+#define P6SEL0              SIM_PORT_EVEN(0x0240, 0x0A)
+#define P6SEL1              SIM_PORT_EVEN(0x0240, 0x0C)
+#define P7OUT               SIM_PORT_ODD(0x0260, 0x02)
+#define P7DIR               SIM_PORT_ODD(0x0260, 0x04)
+#define P7REN               SIM_PORT_ODD(0x0260, 0x06)
+#define P7SEL0              SIM_PORT_ODD(0x0260, 0x0A)
+#define P7SEL1              SIM_PORT_ODD(0x0260, 0x0C)
+#define P8OUT               SIM_PORT_EVEN(0x0260, 0x02)
+#define P8DIR               SIM_PORT_EVEN(0x0260, 0x04)
+#define P8REN               SIM_PORT_EVEN(0x0260, 0x06)
+#define P8SEL0              SIM_PORT_EVEN(0x0260, 0x0A)
+#define P8SEL1              SIM_PORT_EVEN(0x0260, 0x0C)
+#define PAOUT               SIM_REG16(0x0202)
+#define PADIR               SIM_REG16(0x0204)
+#define PAREN               SIM_REG16(0x0206)
+#define PASEL0              SIM_REG16(0x020A)
+#define PASEL1              SIM_REG16(0x020C)
+#define PASELC              SIM_REG16(0x0216)
+#define PAIES               SIM_REG16(0x0218)
+#define PAIE                SIM_REG16(0x021A)
+#define PAIFG               SIM_REG16(0x021C)
+#define PBOUT               SIM_REG16(0x0222)
+#define PBDIR               SIM_REG16(0x0224)
+#define PBREN               SIM_REG16(0x0226)
+#define PBSEL0              SIM_REG16(0x022A)
+#define PBSEL1              SIM_REG16(0x022C)
+#define PBSELC              SIM_REG16(0x0236)
+#define PBIES               SIM_REG16(0x0238)
+#define PBIE                SIM_REG16(0x023A)
+#define PBIFG               SIM_REG16(0x023C)
+#define PCOUT               SIM_REG16(0x0242)
+#define PCDIR               SIM_REG16(0x0244)
+#define PCREN               SIM_REG16(0x0246)
+#define PCSEL0              SIM_REG16(0x024A)
+#define PCSEL1              SIM_REG16(0x024C)
+#define PCSELC              SIM_REG16(0x0256)
+#define PDOUT               SIM_REG16(0x0262)
+#define PDDIR               SIM_REG16(0x0264)
+#define PDREN               SIM_REG16(0x0266)
+#define PDSEL0              SIM_REG16(0x026A)
+#define PDSEL1              SIM_REG16(0x026C)
+#define PDSELC              SIM_REG16(0x0276)
+#define PJOUT               SIM_REG16(0x0322)
+#define PJDIR               SIM_REG16(0x0324)
+#define PJREN               SIM_REG16(0x0326)
+#define PJSEL0              SIM_REG16(0x032A)
+#define PJSEL1              SIM_REG16(0x032C)
+#define PJSELC              SIM_REG16(0x0336)
+
+/****************************************************************
+ * Timer_A
+ ***************************************************************/
+#define SIM_TA0             (0x0340)
+#define SIM_TA1             (0x0380)
+#define SIM_TA2             (0x0400)
+#define SIM_TA3             (0x0440)
+
+#define TA0CTL              SIM_REG16(SIM_TA0 + 0x00)
+#define TA0CCTL0            SIM_REG16(SIM_TA0 + 0x02)
+#define TA0CCTL1            SIM_REG16(SIM_TA0 + 0x04)
+#define TA0CCTL2            SIM_REG16(SIM_TA0 + 0x06)
+#define TA0R                SIM_REG16(SIM_TA0 + 0x10)
+#define TA0CCR0             SIM_REG16(SIM_TA0 + 0x12)
+#define TA0CCR1             SIM_REG16(SIM_TA0 + 0x14)
+#define TA0CCR2             SIM_REG16(SIM_TA0 + 0x16)
+#define TA0EX0              SIM_REG16(SIM_TA0 + 0x20)
+#define TA0IV               SIM_REG16(SIM_TA0 + 0x2E)
+#define TA1CTL              SIM_REG16(SIM_TA1 + 0x00)
+#define TA1CCTL0            SIM_REG16(SIM_TA1 + 0x02)
+#define TA1CCTL1            SIM_REG16(SIM_TA1 + 0x04)
+#define TA1CCTL2            SIM_REG16(SIM_TA1 + 0x06)
+#define TA1R                SIM_REG16(SIM_TA1 + 0x10)
+#define TA1CCR0             SIM_REG16(SIM_TA1 + 0x12)
+#define TA1CCR1             SIM_REG16(SIM_TA1 + 0x14)
+#define TA1CCR2             SIM_REG16(SIM_TA1 + 0x16)
+#define TA1EX0              SIM_REG16(SIM_TA1 + 0x20)
+#define TA1IV               SIM_REG16(SIM_TA1 + 0x2E)
+#define TA2CTL              SIM_REG16(SIM_TA2 + 0x00)
+#define TA2CCTL0            SIM_REG16(SIM_TA2 + 0x02)
+#define TA2CCTL1            SIM_REG16(SIM_TA2 + 0x04)
+#define TA2R                SIM_REG16(SIM_TA2 + 0x10)
+#define TA2CCR0             SIM_REG16(SIM_TA2 + 0x12)
+#define TA2CCR1             SIM_REG16(SIM_TA2 + 0x14)
+#define TA2EX0              SIM_REG16(SIM_TA2 + 0x20)
+#define TA2IV               SIM_REG16(SIM_TA2 + 0x2E)
+
+#define TAIFG               (0x0001)
+#define TAIE                (0x0002)
+#define TACLR               (0x0004)
+#define MC__STOP            (0x0000)
+#define MC__UP              (0x0010)
+#define MC__CONTINUOUS      (0x0020)
+#define MC__UPDOWN          (0x0030)
+#define ID__1               (0x0000)
+#define ID__2               (0x0040)
+#define ID__4               (0x0080)
+#define ID__8               (0x00C0)
+#define TASSEL__TACLK       (0x0000)
+#define TASSEL__ACLK        (0x0100)
+#define TASSEL__SMCLK       (0x0200)
+#define TASSEL__INCLK       (0x0300)
+#define CCIFG               (0x0001)
+#define CCIE                (0x0010)
+
+/****************************************************************
+ * RTC_C
+ ***************************************************************/
+#define RTCCTL0             SIM_REG16(0x04A0)
+#define RTCCTL0_L           SIM_REG8(0x04A0)
+#define RTCCTL0_H           SIM_REG8(0x04A1)
+#define RTCCTL1             SIM_REG8(0x04A2)
+#define RTCCTL3             SIM_REG8(0x04A3)
+#define RTCIV               SIM_REG16(0x04AE)
+#define RTCSEC              SIM_REG8(0x04B0)
+#define RTCMIN              SIM_REG8(0x04B1)
+#define RTCHOUR             SIM_REG8(0x04B2)
+#define RTCDOW              SIM_REG8(0x04B3)
+
+#define RTCKEY_H            (0xA5)
+#define RTCRDYIFG           (0x01)
+#define RTCRDYIE            (0x10)
+#define RTCAIE              (0x20)
+#define RTCRDY              (0x10)
+#define RTCMODE             (0x20)
+#define RTCHOLD             (0x40)
+#define RTCBCD              (0x80)
+#define RTCTEV_3            (0x03)
+#define RTCIV__NONE         (0x0000)
+#define RTCIV__RTCOFIFG     (0x0002)
+#define RTCIV__RTCRDYIFG    (0x0004)
+#define RTCIV__RTCTEVIFG    (0x0006)
+#define RTCIV__RTCAIFG      (0x0008)
+
+/****************************************************************
+ * DMA
+ ***************************************************************/
+#define DMACTL0             SIM_REG16(0x0500)
+#define DMACTL4             SIM_REG16(0x0508)
+#define DMAIV               SIM_REG16(0x050E)
+#define DMA0CTL             SIM_REG16(0x0510)
+#define DMA0SA              (sim_addr{ 0x0512 })
+#define DMA0DA              (sim_addr{ 0x0516 })
+#define DMA0SZ              SIM_REG16(0x051A)
+
+#define DMA0TSEL__DMAREQ    (0x0000)
+#define DMA0TSEL_31         (0x001F)
+#define DMAREQ              (0x0001)
+#define DMAABORT            (0x0002)
+#define DMAIE               (0x0004)
+#define DMAIFG              (0x0008)
+#define DMAEN               (0x0010)
+#define DMALEVEL            (0x0020)
+#define DMASRCBYTE          (0x0040)
+#define DMADSTBYTE          (0x0080)
+#define DMASBDB             (DMASRCBYTE | DMADSTBYTE)
+#define DMASRCINCR_3        (0x0300)
+#define DMADSTINCR_3        (0x0C00)
+#define DMADT_0             (0x0000)
+#define DMADT_1             (0x1000)
+#define DMADT_2             (0x2000)
+#define DMAIV__NONE         (0x0000)
+#define DMAIV_DMA0IFG       (0x0002)
+#define DMAIV__DMA1IFG      (0x0004)
+
+/****************************************************************
+ * LCD_C
+ ***************************************************************/
+#define LCDCCTL0            SIM_REG16(0x0A00)
+#define LCDCCTL1            SIM_REG16(0x0A02)
+#define LCDCBLKCTL          SIM_REG16(0x0A04)
+#define LCDCMEMCTL          SIM_REG16(0x0A06)
+#define LCDCVCTL            SIM_REG16(0x0A08)
+#define LCDCPCTL0           SIM_REG16(0x0A0A)
+#define LCDCPCTL1           SIM_REG16(0x0A0C)
+#define LCDCPCTL2           SIM_REG16(0x0A0E)
+#define LCDCPCTL3           SIM_REG16(0x0A10)
+#define LCDCCPCTL           SIM_REG16(0x0A12)
+#define LCDCIV              SIM_REG16(0x0A1E)
+
+#define SIM_LCDM1           (0x0A20)
+#define SIM_LCDBM1          (0x0A40)
+#define SIM_LCDM_SIZE       (0x20)
+#define LCDMEM              (sim_bank<uint8_t>{ SIM_LCDM1 })
+#define LCDBMEM             (sim_bank<uint8_t>{ SIM_LCDBM1 })
+#define LCDM3               SIM_REG8(SIM_LCDM1 + 2)
+#define LCDM14              SIM_REG8(SIM_LCDM1 + 13)
+#define LCDM18              SIM_REG8(SIM_LCDM1 + 17)
+#define LCDBM3              SIM_REG8(SIM_LCDBM1 + 2)
+#define LCDBM14             SIM_REG8(SIM_LCDBM1 + 13)
+#define LCDBM18             SIM_REG8(SIM_LCDBM1 + 17)
+
+#define LCDON               (0x0001)
+#define LCDLP               (0x0002)
+#define LCDSON              (0x0004)
+#define LCDMX0              (0x0008)
+#define LCDMX1              (0x0010)
+#define LCDMX2              (0x0020)
+#define LCDSSEL             (0x0040)
+#define LCDSTATIC           (LCDSON)
+#define LCD2MUX             (LCDMX0 | LCDSON)
+#define LCD3MUX             (LCDMX1 | LCDSON)
+#define LCD4MUX             (LCDMX1 | LCDMX0 | LCDSON)
+#define LCDPRE__1           (0x0000)
+#define LCDPRE__2           (0x0100)
+#define LCDPRE__4           (0x0200)
+#define LCDPRE__8           (0x0300)
+#define LCDPRE__16          (0x0400)
+#define LCDPRE__32          (0x0500)
+#define LCDDIV__1           (0x0000)
+#define LCDDIV__2           (0x0800)
+#define LCDDIV__3           (0x1000)
+#define LCDDIV__4           (0x1800)
+#define LCDDIV__5           (0x2000)
+#define LCDDIV__6           (0x2800)
+#define LCDDIV__7           (0x3000)
+#define LCDDIV__8           (0x3800)
+#define LCDDIV__16          (0x7800)
+#define LCDDIV__32          (0xF800)
+
+#define LCDDISP             (0x0001)
+#define LCDCLRM             (0x0002)
+#define LCDCLRBM            (0x0004)
+
+#define LCDBLKMOD_0         (0x0000)
+#define LCDBLKMOD_1         (0x0001)
+#define LCDBLKMOD_2         (0x0002)
+#define LCDBLKMOD_3         (0x0003)
+
+#define LCDBLKPRE_0         (0x0000)
+#define LCDBLKPRE_1         (0x0004)
+#define LCDBLKPRE_2         (0x0008)
+#define LCDBLKPRE_3         (0x000C)
+#define LCDBLKPRE_4         (0x0010)
+#define LCDBLKPRE_5         (0x0014)
+#define LCDBLKPRE_6         (0x0018)
+#define LCDBLKPRE_7         (0x001C)
+
+#define LCDBLKDIV_0         (0x0000)
+#define LCDBLKDIV_1         (0x0020)
+#define LCDBLKDIV_2         (0x0040)
+#define LCDBLKDIV_3         (0x0060)
+#define LCDBLKDIV_4         (0x0080)
+#define LCDBLKDIV_5         (0x00A0)
+#define LCDBLKDIV_6         (0x00C0)
+#define LCDBLKDIV_7         (0x00E0)
+
+#define LCD2B               (0x0001)
+#define LCDCPEN             (0x0008)
+#define VLCDEXT             (0x0010)
+#define VLCD_0              (0x0000)
+#define VLCD_1              (0x0200)
+#define VLCD_2              (0x0400)
+#define VLCD_3              (0x0600)
+#define VLCD_4              (0x0800)
+#define VLCD_5              (0x0A00)
+#define VLCD_6              (0x0C00)
+#define VLCD_7              (0x0E00)
+#define VLCD_8              (0x1000)
+#define VLCD_9              (0x1200)
+#define VLCD_10             (0x1400)
+#define VLCD_11             (0x1600)
+#define VLCD_12             (0x1800)
+#define VLCD_13             (0x1A00)
+#define VLCD_14             (0x1C00)
+#define VLCD_15             (0x1E00)
+
+#define LCDCPCLKSYNC        (0x8000)
+
+#define LCDS0               (0x0001)
+#define LCDS1               (0x0002)
+#define LCDS2               (0x0004)
+#define LCDS3               (0x0008)
+#define LCDS4               (0x0010)
+#define LCDS5               (0x0020)
+#define LCDS6               (0x0040)
+#define LCDS7               (0x0080)
+#define LCDS8               (0x0100)
+#define LCDS9               (0x0200)
+#define LCDS10              (0x0400)
+#define LCDS11              (0x0800)
+#define LCDS12              (0x1000)
+#define LCDS13              (0x2000)
+#define LCDS14              (0x4000)
+#define LCDS15              (0x8000)
+#define LCDS16              (0x0001)
+#define LCDS17              (0x0002)
+#define LCDS18              (0x0004)
+#define LCDS19              (0x0008)
+#define LCDS20              (0x0010)
+#define LCDS21              (0x0020)
+#define LCDS22              (0x0040)
+#define LCDS23              (0x0080)
+#define LCDS24              (0x0100)
+#define LCDS25              (0x0200)
+#define LCDS26              (0x0400)
+#define LCDS27              (0x0800)
+#define LCDS28              (0x1000)
+#define LCDS29              (0x2000)
+#define LCDS30              (0x4000)
+#define LCDS31              (0x8000)
+#define LCDS32              (0x0001)
+#define LCDS33              (0x0002)
+#define LCDS34              (0x0004)
+#define LCDS35              (0x0008)
+#define LCDS36              (0x0010)
+#define LCDS37              (0x0020)
+#define LCDS38              (0x0040)
+#define LCDS39              (0x0080)
+
+#endif /* SIM_MSP430_H_ */
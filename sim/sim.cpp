@@ -0,0 +1,428 @@
+/****************************************************************
+ * Author: John J. Patti
+ *
+ * Version: 0.1
+ * Description: LCD_C Register Simulator
+ * File: sim.cpp
+ *
+ * Copyright (c) 2020, John J. Patti
+ * All rights reserved.
+ *
+ * Documents:
+ *  Technical Reference Manual for the MSP430FR6989
+ *  (Document No. SLAU367O) ("TRM")
+ *
+ *  Datasheet for the MSP430FR6989 ("Datasheet")
+ *
+ *  MSP430FR6989 LaunchPad DevelopmentKit(MSP--EXP430FR6989)
+ *  User's Guide (Document No. SLAU627A) ("User's Guide")
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the Software), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ ***************************************************************/
+
+#include "sim.h"
+#include <msp430.h>
+#include <stdint.h>
+#include <string.h>
+
+/****************************************************************
+ * Globals
+ ***************************************************************/
+sim_stats_t sim_stats;
+uint8_t sim_mem[SIM_MEM_SIZE];
+int sim_lfxt_fault;
+uint16_t sim_sr;
+
+static void (*sim_idle_hook)(uint16_t sr);
+static volatile uint8_t *sim_dma_sa;         // DMA0SA as a host address
+static volatile uint8_t *sim_dma_da;         // DMA0DA as a host address
+
+/***************************************************************
+ * @brief   Resets the simulated register file and counters
+ * @param   None
+ * @return  None
+ **************************************************************/
+void sim_reset(void)
+{
+    memset(sim_mem, 0, sizeof(sim_mem));
+    sim_idle_hook = 0;
+    sim_sr = 0;
+    sim_dma_sa = 0;
+    sim_dma_da = 0;
+    sim_reset_stats();
+}
+
+/***************************************************************
+ * @brief   Resets the access counters only
+ * @param   None
+ * @return  None
+ **************************************************************/
+void sim_reset_stats(void)
+{
+    memset(&sim_stats, 0, sizeof(sim_stats));
+}
+
+/***************************************************************
+ * @brief   Returns non-zero if "addr" is LCD or blink memory
+ * @param   "addr" - register address
+ * @return  1 if LCDMEM/LCDBMEM, otherwise 0
+ **************************************************************/
+static int sim_is_lcdmem(uint16_t addr)
+{
+    return addr >= SIM_LCDM1 && addr < SIM_LCDBM1 + SIM_LCDM_SIZE;
+}
+
+/***************************************************************
+ * @brief   Runs a software-triggered DMA channel 0 block
+ * @param   None
+ * @return  None
+ *
+ * Only what liblcd uses is modelled: a single block or
+ * burst-block of DMA0SZ bytes, started by DMAREQ, with fixed or
+ * incrementing byte addresses.  The block completes at once,
+ * before the write that started it returns.  The bytes are not
+ * counted as CPU writes; they are counted in sim_stats.dma at
+ * SIM_CYC_DMA cycles each.
+ **************************************************************/
+static void sim_dma(void)
+{
+    uint16_t ctl = sim_peek(0x0510, 2), n = sim_peek(0x051A, 2);
+    volatile uint8_t *src = sim_dma_sa, *dst = sim_dma_da;
+
+    if ((ctl & (DMAEN | DMAREQ)) != (DMAEN | DMAREQ) || !src || !dst)
+        return;
+    while (n--)
+    {
+        *dst = *src;
+        if ((ctl & DMASRCINCR_3) == DMASRCINCR_3)
+            src++;
+        if ((ctl & DMADSTINCR_3) == DMADSTINCR_3)
+            dst++;
+        sim_stats.dma++;
+        sim_stats.cycles += SIM_CYC_DMA;
+    }
+    ctl = (ctl & ~(DMAEN | DMAREQ)) | DMAIFG;   // Single block done
+    sim_mem[0x0510] = ctl & 0xFF;
+    sim_mem[0x0511] = ctl >> 8;
+    if (ctl & DMAIE)
+        sim_mem[0x050E] = DMAIV_DMA0IFG;
+}
+
+/***************************************************************
+ * @brief   Returns non-zero if "addr" is a PxSELC register
+ * @param   "addr" - register address
+ * @return  1 for PASELC to PDSELC and PJSELC, otherwise 0
+ **************************************************************/
+static int sim_is_selc(uint16_t addr)
+{
+    return ((addr & 0xFF9E) == 0x0216 && addr < 0x0280) ||
+           (addr & 0xFFFE) == 0x0336;
+}
+
+/***************************************************************
+ * @brief   Reads a register without counting the access
+ * @param   "addr"  - register address
+ *          "width" - 1 or 2 bytes
+ * @return  Register value
+ **************************************************************/
+uint16_t sim_peek(uint16_t addr, uint8_t width)
+{
+    if (width == 1)
+        return sim_mem[addr];
+    return (uint16_t) (sim_mem[addr] | (sim_mem[(uint16_t) (addr + 1)] << 8));
+}
+
+/***************************************************************
+ * @brief   Stores a register value and applies the side effects
+ *          of the peripheral that owns the address
+ * @param   "addr"  - register address
+ *          "val"   - new value
+ *          "width" - 1 or 2 bytes
+ * @return  None
+ **************************************************************/
+static void sim_store(uint16_t addr, uint16_t val, uint8_t width)
+{
+    //---------------------------------------------------------|
+    sim_mem[addr] = val & 0xFF;                         //     |
+    if (width == 2)                                     //     |
+        sim_mem[(uint16_t) (addr + 1)] = val >> 8;      //     |
+                                                        //     |
+    if (addr == 0x0A06 && (val & LCDCLRM))              // LCD |
+    {                                                   // mem |
+        memset(&sim_mem[SIM_LCDM1], 0, SIM_LCDM_SIZE);  // clr |
+        sim_mem[addr] &= ~LCDCLRM;                      //     |
+    }                                                   //     |
+    if (addr == 0x0A06 && (val & LCDCLRBM))             // LCD |
+    {                                                   // blk |
+        memset(&sim_mem[SIM_LCDBM1], 0, SIM_LCDM_SIZE); // clr |
+        sim_mem[addr] &= ~LCDCLRBM;                     //     |
+    }                                                   //     |
+    if (sim_is_selc(addr))                              // SELC|
+    {                                                   // flip|
+        sim_mem[addr - 0x0C] ^= val & 0xFF;             // SEL0|
+        sim_mem[addr - 0x0A] ^= val & 0xFF;             // and |
+        if (width == 2)                                 // SEL1|
+        {                                               //     |
+            sim_mem[addr - 0x0B] ^= val >> 8;           //     |
+            sim_mem[addr - 0x09] ^= val >> 8;           //     |
+        }                                               //     |
+        sim_mem[addr] = 0;                              //     |
+        if (width == 2)                                 //     |
+            sim_mem[addr + 1] = 0;                      //     |
+    }                                                   //     |
+    if (sim_lfxt_fault && !(sim_mem[0x0168] & LFXTOFF)) // No  |
+    {                                                   // LFXT|
+        sim_mem[0x016A] |= LFXTOFFG;                    // keep|
+        sim_mem[0x0102] |= OFIFG;                       // the |
+    }                                                   // flag|
+    if (addr == 0x0510)                                 // DMA |
+        sim_dma();                                      //     |
+    if (sim_is_lcdmem(addr))                            //     |
+        sim_stats.lcd_writes += width;                  //     |
+    //---------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Counted register read
+ * @param   "addr"  - register address
+ *          "width" - 1 or 2 bytes
+ * @return  Register value
+ **************************************************************/
+uint16_t sim_read(uint16_t addr, uint8_t width)
+{
+    sim_stats.reads++;
+    sim_stats.cycles += SIM_CYC_READ;
+    return sim_peek(addr, width);
+}
+
+/***************************************************************
+ * @brief   Counted register write
+ * @param   "addr"  - register address
+ *          "val"   - new value
+ *          "width" - 1 or 2 bytes
+ * @return  None
+ **************************************************************/
+void sim_write(uint16_t addr, uint16_t val, uint8_t width)
+{
+    sim_stats.writes++;
+    sim_stats.cycles += SIM_CYC_WRITE;
+    sim_store(addr, val, width);
+}
+
+/***************************************************************
+ * @brief   Counted read-modify-write (BIS/BIC/XOR to memory)
+ * @param   "addr"  - register address
+ *          "val"   - value after modification
+ *          "width" - 1 or 2 bytes
+ * @return  None
+ **************************************************************/
+void sim_modify(uint16_t addr, uint16_t val, uint8_t width)
+{
+    sim_stats.reads++;
+    sim_stats.writes++;
+    sim_stats.cycles += SIM_CYC_RMW;
+    sim_store(addr, val, width);
+}
+
+/***************************************************************
+ * @brief   Counted write of a DMA address register
+ * @param   "addr" - DMA0SA or DMA0DA
+ *          "p"    - host address of the source or destination
+ * @return  None
+ **************************************************************/
+void sim_set_addr(uint16_t addr, const volatile void *p)
+{
+    sim_stats.writes++;
+    sim_stats.cycles += SIM_CYC_WRITE;
+    if (addr == 0x0512)
+        sim_dma_sa = (volatile uint8_t *) p;
+    else if (addr == 0x0516)
+        sim_dma_da = (volatile uint8_t *) p;
+}
+
+/***************************************************************
+ * @brief   Replacement for __delay_cycles(); accounts the cycles
+ *          instead of spinning
+ * @param   "cycles" - requested delay
+ * @return  None
+ **************************************************************/
+void sim_delay(unsigned long cycles)
+{
+    sim_stats.delay += cycles;
+    sim_stats.cycles += cycles;
+}
+
+/***************************************************************
+ * @brief   Registers a hook run whenever the library enters a
+ *          low-power mode (stands in for pending interrupts)
+ * @param   "hook" - callback, or 0 to remove
+ * @return  None
+ **************************************************************/
+void sim_set_idle_hook(void (*hook)(uint16_t sr))
+{
+    sim_idle_hook = hook;
+}
+
+/***************************************************************
+ * @brief   Replacement for __bis_SR_register()
+ * @param   "sr" - status register bits being set
+ * @return  None
+ *
+ * GIE stays set after the wake-up; the low-power bits are
+ * cleared by the ISR on exit, so they are not kept.
+ **************************************************************/
+void sim_idle(uint16_t sr)
+{
+    sim_sr |= sr & GIE;
+    sim_stats.sleeps++;
+    if (sim_idle_hook)
+        sim_idle_hook(sr);
+}
+
+static const uint8_t sim_pos[6] = { 9, 5, 3, 18, 14, 7 };    // LCD_A1..LCD_A6
+static const char *sim_ind[6][2] = {                        // bit 2 / bit 0 names
+    { "NEG", "DP1" }, { "COL1", "DP2" }, { "ANT", "DP3" },
+    { "COL2", "DP4" }, { "DEG", "DP5" }, { "TX", "RX" } };
+static const char *sim_at[3][8] = {                         // AT1, AT2, AT3 names
+    { "!", "REC", "HRT", "TMR", 0, 0, 0, 0 },
+    { 0, 0, 0, 0, "[]", "B1", "B3", "B5" },
+    { 0, 0, 0, 0, "BATT", "B2", "B4", "B6" } };
+static const uint8_t sim_at_pos[3] = { 2, 17, 13 };
+
+/***************************************************************
+ * @brief   Returns the LCD memory bank on display
+ * @param   None
+ * @return  LCD Memory 1 of LCDMEM, or of LCDBMEM when LCDDISP
+ *          selects it (only honoured while blinking is off)
+ **************************************************************/
+const uint8_t *sim_visible(void)
+{
+    if ((sim_peek(0x0A06, 2) & LCDDISP) &&
+        (sim_peek(0x0A04, 2) & 0x0003) == LCDBLKMOD_0)
+        return &sim_mem[SIM_LCDBM1];
+    return &sim_mem[SIM_LCDM1];
+}
+
+/***************************************************************
+ * @brief   Lists the indicators and symbols set in a bank
+ * @param   "mem"  - LCD Memory 1 of LCDMEM or LCDBMEM
+ *          "buf"  - output, names separated by one blank, e.g.
+ *                   "COL1 DP4 TMR"; empty if none
+ *          "size" - size of "buf"
+ * @return  None
+ **************************************************************/
+void sim_indicators(const uint8_t *mem, char *buf, size_t size)
+{
+    //----------------------------------------------------------------------------------|
+    const char *name[6 * 2 + 3 * 8];                        // Names found              |
+    size_t n = 0, len = 0, k;                               //                          |
+    int i, b;                                               //                          |
+                                                            ////////////////////////////|
+    for (i = 0; i < 6; i++)                                 // Position indicators      |
+    {                                                       //                          |
+        uint8_t lo = mem[sim_pos[i] + 1];                   //                          |
+        if (lo & 0x04) name[n++] = sim_ind[i][0];           //                          |
+        if (lo & 0x01) name[n++] = sim_ind[i][1];           //                          |
+    }                                                       //                          |
+    for (i = 0; i < 3; i++)                                 // AT1-AT3 symbols          |
+        for (b = 0; b < 8; b++)                             //                          |
+            if (sim_at[i][b] && (mem[sim_at_pos[i]] & (1 << b)))                    //  |
+                name[n++] = sim_at[i][b];                   //                          |
+                                                            ////////////////////////////|
+    buf[0] = '\0';                                          //                          |
+    for (k = 0; k < n; k++)                                 //                          |
+        len += snprintf(buf + len, len < size ? size - len : 0,                     //  |
+                        k ? " %s" : "%s", name[k]);         //                          |
+    //----------------------------------------------------------------------------------|
+}
+
+/***************************************************************
+ * @brief   Renders the visible LCD frame as text
+ * @param   "out" - output stream
+ * @return  None
+ *
+ * Each 14-segment position is drawn in a 5x5 cell using the
+ * bit layout documented in liblcd.c:
+ *
+ *              high byte: A B C D E F G M
+ *              low byte:  H J K P Q - N dp
+ *
+ * The indicator bits (bit 2 and bit 0 of the low byte) and the
+ * AT1-AT3 symbol bytes are listed on the line below the frame.
+ **************************************************************/
+void sim_render(FILE *out)
+{
+    //----------------------------------------------------------------------------------|
+    char rows[5][6 * 6 + 1];                                // Text frame               |
+    char names[128];                                        // Indicator list           |
+    const uint8_t *mem = sim_visible();                     // Bank on display          |
+    int i, r;                                               //                          |
+                                                            ////////////////////////////|
+    memset(rows, ' ', sizeof(rows));                        //                          |
+    for (i = 0; i < 6; i++)                                 // Draw each position       |
+    {                                                       //                          |
+        uint8_t hi = mem[sim_pos[i]], lo = mem[sim_pos[i] + 1];                     //  |
+        char *c0 = &rows[0][i * 6], *c1 = &rows[1][i * 6];  //                          |
+        char *c2 = &rows[2][i * 6], *c3 = &rows[3][i * 6];  //                          |
+        char *c4 = &rows[4][i * 6];                         //                          |
+                                                            //                          |
+        if (hi & 0x80) { c0[1] = c0[2] = c0[3] = '_'; }     // A                        |
+        if (hi & 0x04) c1[0] = '|';                         // F                        |
+        if (lo & 0x80) c1[1] = '\\';                        // H                        |
+        if (lo & 0x40) c1[2] = '|';                         // J                        |
+        if (lo & 0x20) c1[3] = '/';                         // K                        |
+        if (hi & 0x40) c1[4] = '|';                         // B                        |
+        if (hi & 0x02) c2[1] = '-';                         // G                        |
+        if (hi & 0x01) c2[3] = '-';                         // M                        |
+        if ((hi & 0x03) == 0x03) c2[2] = '-';               //                          |
+        if (hi & 0x08) c3[0] = '|';                         // E                        |
+        if (lo & 0x08) c3[1] = '/';                         // Q                        |
+        if (lo & 0x10) c3[2] = '|';                         // P                        |
+        if (lo & 0x02) c3[3] = '\\';                        // N                        |
+        if (hi & 0x20) c3[4] = '|';                         // C                        |
+        if (hi & 0x10) { c4[1] = c4[2] = c4[3] = '_'; }     // D                        |
+        if ((lo & 0x01) && i < 5) c4[5] = '.';              // dp                       |
+        if ((lo & 0x04) && (i == 1 || i == 3))              // colon                    |
+            c1[5] = c3[5] = '.';                            //                          |
+    }                                                       //                          |
+    for (r = 0; r < 5; r++)                                 // Emit frame               |
+    {                                                       //                          |
+        rows[r][6 * 6] = '\0';                              //                          |
+        fprintf(out, "  %s\n", rows[r]);                    //                          |
+    }                                                       //                          |
+                                                            ////////////////////////////|
+    sim_indicators(mem, names, sizeof(names));              // Indicator list           |
+    fprintf(out, "  [%s%s ]", *names ? " " : "", names);    //                          |
+    if ((sim_peek(0x0A04, 2) & 0x0003) == LCDBLKMOD_1)      // Positions blinking in    |
+    {                                                       // hardware                 |
+        fprintf(out, " blink:");                            //                          |
+        for (i = 0; i < 6; i++)                             //                          |
+            if (sim_mem[SIM_LCDBM1 + sim_pos[i]] |          //                          |
+                (sim_mem[SIM_LCDBM1 + sim_pos[i] + 1] & 0xFA))                      //  |
+                fprintf(out, " A%d", i + 1);                //                          |
+        sim_indicators(&sim_mem[SIM_LCDBM1], names, sizeof(names));                 //  |
+        if (*names)                                         // Indicators and symbols   |
+            fprintf(out, " %s", names);                     //                          |
+    }                                                       //                          |
+    fprintf(out, "\n");                                     //                          |
+    //----------------------------------------------------------------------------------|
+}
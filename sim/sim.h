@@ -0,0 +1,113 @@
+/****************************************************************
+ * Author: John J. Patti
+ *
+ * Version: 0.1
+ * Description: LCD_C Register Simulator
+ * File: sim.h
+ *
+ * Copyright (c) 2020, John J. Patti
+ * All rights reserved.
+ *
+ * Documents:
+ *  Technical Reference Manual for the MSP430FR6989
+ *  (Document No. SLAU367O) ("TRM")
+ *
+ *  Datasheet for the MSP430FR6989 ("Datasheet")
+ *
+ *  MSP430FR6989 LaunchPad DevelopmentKit(MSP--EXP430FR6989)
+ *  User's Guide (Document No. SLAU627A) ("User's Guide")
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the Software), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ ***************************************************************/
+
+#ifndef SIM_H_
+#define SIM_H_
+
+/****************************************************************
+ * Header includes
+ ***************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+
+/****************************************************************
+ * Defines
+ ***************************************************************/
+//---------------------------------------------------------|
+///////////////////////////////////////////////////////////|
+// Estimated MSP430X cycle cost of a single peripheral     |
+// access using absolute addressing.  See the instruction  |
+// cycle tables in Chapter 4 of the TRM.                   |
+//                                                         |
+//   read  - MOV.x  &EDE,Rn                                |
+//   write - MOV.x  Rn,&EDE  (or #N,&EDE)                  |
+//   rmw   - BIS.x/BIC.x/XOR.x  #N,&EDE                     |
+//                                                         |
+// Only register traffic and __delay_cycles() are counted; |
+// ordinary CPU work between accesses is not modelled.     |
+///////////////////////////////////////////////////////////|
+//---------------------------------------------------------|
+#define SIM_CYC_READ        (3)
+#define SIM_CYC_WRITE       (4)
+#define SIM_CYC_RMW         (5)
+#define SIM_CYC_DMA         (2)     // Per byte of a DMA block transfer
+
+#define SIM_MEM_SIZE        (0x10000)
+
+/****************************************************************
+ * Typedefs and Structs
+ ***************************************************************/
+typedef struct{
+    unsigned long reads;        // Volatile register reads
+    unsigned long writes;       // Volatile register writes
+    unsigned long lcd_writes;   // Writes landing in LCDMEM/LCDBMEM
+    unsigned long cycles;       // Estimated access cycles
+    unsigned long delay;        // Cycles spent in __delay_cycles
+    unsigned long sleeps;       // Low-power mode entries
+    unsigned long dma;          // Bytes moved by the DMA controller
+} sim_stats_t;
+
+/****************************************************************
+ * Globals
+ ***************************************************************/
+extern sim_stats_t sim_stats;
+extern uint8_t sim_mem[SIM_MEM_SIZE];
+extern int sim_lfxt_fault;            // Non-zero: no LFXT crystal fitted
+extern uint16_t sim_sr;               // Status register; only GIE is kept
+
+/****************************************************************
+ * Forward Declarations
+ ***************************************************************/
+void sim_reset(void);
+void sim_reset_stats(void);
+uint16_t sim_read(uint16_t addr, uint8_t width);
+void sim_write(uint16_t addr, uint16_t val, uint8_t width);
+void sim_modify(uint16_t addr, uint16_t val, uint8_t width);
+uint16_t sim_peek(uint16_t addr, uint8_t width);
+void sim_delay(unsigned long cycles);
+void sim_set_addr(uint16_t addr, const volatile void *p);
+void sim_set_idle_hook(void (*hook)(uint16_t sr));
+void sim_idle(uint16_t sr);
+const uint8_t *sim_visible(void);
+void sim_indicators(const uint8_t *mem, char *buf, size_t size);
+void sim_render(FILE *out);
+
+#endif /* SIM_H_ */